@@ -0,0 +1,542 @@
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "brick_game/snake/autopilot.h"
+#include "brick_game/snake/backend.h"
+#include "brick_game/snake/batch.h"
+#include "brick_game/snake/cycle_pilot.h"
+#include "brick_game/snake/fixed_engine.h"
+#include "brick_game/snake/observation.h"
+#include "brick_game/snake/replay.h"
+#include "brick_game/snake/rules.h"
+#include "brick_game/snake/search.h"
+#include "brick_game/snake/snake_env.h"
+
+using namespace s21::snake;
+
+namespace {
+
+// Гамильтонов цикл по полю с четной высотой: змейка идет "змейкой" по
+// строкам, начиная с x = 1, и возвращается наверх по столбцу x = 0.
+// Такая стратегия никогда не умирает, поэтому позволяет вырастить змейку
+// любой длины.
+Event cycleMove(const Point& h, int w, int hgt) {
+  if (h.x == 0) return h.y == 0 ? Event::kMoveRight : Event::kMoveUp;
+  if (h.y % 2 == 0) return h.x < w - 1 ? Event::kMoveRight : Event::kMoveDown;
+  if (h.x > 1) return Event::kMoveLeft;
+  return h.y == hgt - 1 ? Event::kMoveLeft : Event::kMoveDown;
+}
+
+void cycleTick(Engine& e, int w, int h) {
+  e.dispatch(cycleMove(e.head(), w, h));
+  e.dispatch(Event::kTick);
+}
+
+}  // namespace
+
+static void BM_TickVsLength(benchmark::State& state) {
+  const int w = 64, h = 64;
+  const auto target = static_cast<std::size_t>(state.range(0));
+  Engine e{Config{w, h, 42, false, {}, false}};
+  e.dispatch(Event::kStart);
+  while (e.length() < target && e.state() == State::kRunning)
+    cycleTick(e, w, h);
+
+  for (auto _ : state) cycleTick(e, w, h);
+
+  state.counters["length"] = static_cast<double>(e.length());
+}
+BENCHMARK(BM_TickVsLength)
+    ->Arg(16)
+    ->Arg(128)
+    ->Arg(512)
+    ->Arg(1024)
+    ->Arg(2048)
+    ->Iterations(20000);
+
+static void BM_Snapshot(benchmark::State& state) {
+  const int side = static_cast<int>(state.range(0));
+  Engine e{Config{side, side, 42, false, {}, false}};
+  e.dispatch(Event::kStart);
+
+  for (auto _ : state) {
+    auto s = e.snapshot();
+    benchmark::DoNotOptimize(s.grid.data());
+  }
+  state.SetBytesProcessed(state.iterations() * side * side *
+                          sizeof(Cell::Type));
+}
+BENCHMARK(BM_Snapshot)->Arg(20)->Arg(200)->Arg(1000);
+
+// Цена одного тика с включенным и выключенным wrap при фиксированной длине.
+// 64 — путь через маску степени двойки, 60 — общий путь.
+static void BM_TickWrap(benchmark::State& state) {
+  const int side = static_cast<int>(state.range(0));
+  const bool wrap = state.range(1) != 0;
+  Engine e{Config{side, side, 42, wrap, {}, false}};
+  e.dispatch(Event::kStart);
+  while (e.length() < 256 && e.state() == State::kRunning)
+    cycleTick(e, side, side);
+
+  for (auto _ : state) cycleTick(e, side, side);
+
+  state.counters["length"] = static_cast<double>(e.length());
+}
+BENCHMARK(BM_TickWrap)
+    ->ArgNames({"side", "wrap"})
+    ->ArgsProduct({{60, 64}, {0, 1}})
+    ->Iterations(20000);
+
+// Один и тот же путь по гамильтонову циклу: через dispatch() и через run()
+static void BM_DispatchLoop(benchmark::State& state) {
+  const int w = 64, h = 64;
+  Engine e{Config{w, h, 42, false, {}, false}};
+  e.dispatch(Event::kStart);
+  for (auto _ : state) {
+    for (int t = 0; t < 1000; ++t) cycleTick(e, w, h);
+  }
+  state.counters["ticks/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) * 1000,
+      benchmark::Counter::kIsRate);
+  state.counters["length"] = static_cast<double>(e.length());
+}
+BENCHMARK(BM_DispatchLoop)->Iterations(200);
+
+static void BM_RunLoop(benchmark::State& state) {
+  const int w = 64, h = 64;
+  Engine e{Config{w, h, 42, false, {}, false}};
+  e.dispatch(Event::kStart);
+  auto policy = [](const Engine& en) {
+    switch (cycleMove(en.head(), w, h)) {
+      case Event::kMoveUp:
+        return Direction::kUp;
+      case Event::kMoveDown:
+        return Direction::kDown;
+      case Event::kMoveLeft:
+        return Direction::kLeft;
+      default:
+        return Direction::kRight;
+    }
+  };
+  for (auto _ : state) e.run(1000, policy);
+  state.counters["ticks/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) * 1000,
+      benchmark::Counter::kIsRate);
+  state.counters["length"] = static_cast<double>(e.length());
+}
+BENCHMARK(BM_RunLoop)->Iterations(200);
+
+namespace {
+
+// Поворот по часовой стрелке, если впереди стена: партии живут долго и не
+// требуют перезапуска на каждом шаге.
+Direction avoidWalls(Point h, Direction d, int w, int hgt) {
+  switch (d) {
+    case Direction::kRight:
+      return h.x + 1 < w ? d : (h.y + 1 < hgt ? Direction::kDown
+                                               : Direction::kUp);
+    case Direction::kDown:
+      return h.y + 1 < hgt ? d : (h.x > 0 ? Direction::kLeft
+                                          : Direction::kRight);
+    case Direction::kLeft:
+      return h.x > 0 ? d : (h.y > 0 ? Direction::kUp : Direction::kDown);
+    case Direction::kUp:
+      break;
+  }
+  return h.y > 0 ? d : (h.x + 1 < w ? Direction::kRight : Direction::kLeft);
+}
+
+}  // namespace
+
+static void BM_BatchStep(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0)), w = 20, h = 20;
+  const auto kernel = static_cast<BatchKernel>(state.range(1));
+  SnakeBatch batch(n, w, h, state.range(2) != 0);
+  if (!batch.setKernel(kernel)) {
+    state.SkipWithError("kernel not supported on this CPU");
+    return;
+  }
+  for (int g = 0; g < n; ++g) batch.reset(g, 1u + g);
+  std::vector<Direction> actions(n);
+
+  for (auto _ : state) {
+    for (int g = 0; g < n; ++g) {
+      if (batch.state(g) != State::kRunning) batch.reset(g, 7u + g);
+      actions[g] = avoidWalls(batch.head(g), batch.direction(g), w, h);
+    }
+    batch.step(actions);
+  }
+  state.counters["game_ticks/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) * n, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_BatchStep)
+    ->ArgNames({"games", "kernel", "wrap"})
+    ->ArgsProduct({{1024, 16384},
+                   {static_cast<int>(BatchKernel::kScalar),
+                    static_cast<int>(BatchKernel::kSse2),
+                    static_cast<int>(BatchKernel::kAvx2)},
+                   {0, 1}});
+
+static void BM_EngineLoop(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0)), w = 20, h = 20;
+  std::vector<std::unique_ptr<Engine>> engines;
+  std::vector<Direction> dirs(n, Direction::kRight);
+  for (int g = 0; g < n; ++g) {
+    engines.push_back(
+        std::make_unique<Engine>(Config{w, h, 1u + g, false, {}, false}));
+    engines.back()->dispatch(Event::kStart);
+  }
+  const Event move[] = {Event::kMoveUp, Event::kMoveDown, Event::kMoveLeft,
+                        Event::kMoveRight};
+
+  for (auto _ : state) {
+    for (int g = 0; g < n; ++g) {
+      Engine& e = *engines[g];
+      if (e.state() != State::kRunning) {
+        e.dispatch(Event::kStart);
+        dirs[g] = Direction::kRight;
+      }
+      dirs[g] = avoidWalls(e.head(), dirs[g], w, h);
+      e.dispatch(move[static_cast<int>(dirs[g])]);
+      e.dispatch(Event::kTick);
+    }
+  }
+  state.counters["game_ticks/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) * n, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_EngineLoop)->Arg(1024)->Arg(16384);
+
+namespace {
+
+// Первый безопасный ход по часовой стрелке от текущего направления.
+// Работает с любым движком, у которого есть head/direction/isSnakeCell.
+template <class E>
+Direction clockwiseSafe(const E& e, int w, int h) {
+  static constexpr Direction kNext[] = {Direction::kRight, Direction::kLeft,
+                                        Direction::kUp, Direction::kDown};
+  Direction d = e.direction();
+  for (int k = 0; k < 4; ++k, d = kNext[static_cast<int>(d)]) {
+    const int x = e.head().x + (d == Direction::kRight) -
+                  (d == Direction::kLeft);
+    const int y = e.head().y + (d == Direction::kDown) - (d == Direction::kUp);
+    if (x >= 0 && x < w && y >= 0 && y < h && !e.isSnakeCell(x, y)) return d;
+  }
+  return e.direction();
+}
+
+template <class E>
+void runGames(benchmark::State& state, E& e, int w, int h) {
+  std::int64_t ticks = 0;
+  auto policy = [w, h](const E& en) { return clockwiseSafe(en, w, h); };
+  for (auto _ : state) {
+    if (e.state() != State::kRunning) e.dispatch(Event::kStart);
+    ticks += e.run(1000, policy).ticks;
+  }
+  state.counters["ticks/s"] = benchmark::Counter(
+      static_cast<double>(ticks), benchmark::Counter::kIsRate);
+}
+
+}  // namespace
+
+// Один и тот же бот на Engine и на FixedEngine<W, H>
+static void BM_RuntimeSized(benchmark::State& state) {
+  const int side = static_cast<int>(state.range(0));
+  Engine e{Config{side, side, 42, false, {}, false}};
+  runGames(state, e, side, side);
+}
+BENCHMARK(BM_RuntimeSized)->Arg(10)->Arg(20);
+
+template <int N>
+static void BM_FixedSized(benchmark::State& state) {
+  FixedEngine<N, N> e{42};
+  runGames(state, e, N, N);
+}
+BENCHMARK_TEMPLATE(BM_FixedSized, 10);
+BENCHMARK_TEMPLATE(BM_FixedSized, 20);
+
+// Воспроизведение записанной партии: 20000 тиков по гамильтонову циклу
+static void BM_ReplayPlayback(benchmark::State& state) {
+  const int w = 20, h = 20;
+  const Config cfg{w, h, 42, false, {}, false};
+  Engine e{cfg};
+  ReplayRecorder rec{cfg};
+  e.dispatch(Event::kStart);
+  rec.record(Event::kStart);
+  for (int t = 0; t < 20000 && e.state() == State::kRunning; ++t) {
+    const Event move = cycleMove(e.head(), w, h);
+    e.dispatch(move);
+    rec.record(move);
+    e.dispatch(Event::kTick);
+    rec.record(Event::kTick);
+  }
+  rec.finish(e.view().score);
+
+  std::uint64_t ticks = 0;
+  for (auto _ : state) ticks += playReplay(rec.bytes()).ticks;
+  state.counters["ticks/s"] = benchmark::Counter(
+      static_cast<double>(ticks), benchmark::Counter::kIsRate);
+  state.counters["bytes"] = static_cast<double>(rec.bytes().size());
+}
+BENCHMARK(BM_ReplayPlayback);
+
+// Клон для поиска: копия с выделением памяти, cloneInto() в арену и блок
+static void BM_CopyEngine(benchmark::State& state) {
+  Engine root{Config{20, 20, 42, false, {}, false}};
+  root.dispatch(Event::kStart);
+  for (auto _ : state) {
+    Engine copy = root;
+    benchmark::DoNotOptimize(&copy);
+  }
+}
+BENCHMARK(BM_CopyEngine);
+
+static void BM_CloneInto(benchmark::State& state) {
+  Engine root{Config{20, 20, 42, false, {}, false}};
+  root.dispatch(Event::kStart);
+  Engine arena = root;
+  for (auto _ : state) {
+    root.cloneInto(arena);
+    benchmark::DoNotOptimize(&arena);
+  }
+}
+BENCHMARK(BM_CloneInto);
+
+static void BM_SaveLoadState(benchmark::State& state) {
+  Engine root{Config{20, 20, 42, false, {}, false}};
+  root.dispatch(Event::kStart);
+  Engine arena = root;
+  std::vector<std::uint8_t> blob;
+  for (auto _ : state) {
+    root.saveState(blob);
+    benchmark::DoNotOptimize(arena.loadState(blob));
+  }
+  state.counters["bytes"] = static_cast<double>(blob.size());
+}
+BENCHMARK(BM_SaveLoadState);
+
+// Наблюдения для агентов: байт/с показывает близость к пропускной
+// способности памяти
+template <class T>
+static void BM_ObserveBatch(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0)), w = 20, h = 20;
+  SnakeBatch batch(n, w, h);
+  for (int g = 0; g < n; ++g) batch.reset(g, 1u + g);
+  std::vector<T> tensor(n * observationSize(w, h));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(batch.observe(tensor));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          tensor.size() * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_ObserveBatch, std::uint8_t)->Arg(256)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_ObserveBatch, float)->Arg(256)->Arg(4096);
+
+static void BM_ObserveEngines(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0)), w = 20, h = 20;
+  std::vector<Engine> engines;
+  engines.reserve(n);
+  std::vector<const Engine*> ptrs;
+  for (int g = 0; g < n; ++g) {
+    engines.emplace_back(
+        Config{w, h, 1u + static_cast<unsigned>(g), false, {}, false});
+    engines.back().dispatch(Event::kStart);
+  }
+  for (const Engine& e : engines) ptrs.push_back(&e);
+  std::vector<std::uint8_t> tensor(n * observationSize(w, h));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(observeBatch(ptrs, tensor));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          tensor.size());
+}
+BENCHMARK(BM_ObserveEngines)->Arg(256);
+
+// Шаг C ABI среды с наблюдениями и автоперезапуском
+static void BM_EnvStep(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  snake_env* env = snake_env_create(n, 20, 20, 0);
+  std::vector<std::uint32_t> seeds(n);
+  for (int g = 0; g < n; ++g) seeds[g] = 1u + g;
+  std::vector<std::uint8_t> obs(n * snake_env_obs_size(env)), dones(n);
+  std::vector<float> rewards(n);
+  std::vector<std::int32_t> actions(n);
+  snake_env_reset(env, seeds.data(), obs.data());
+  unsigned r = 1;
+  for (auto _ : state) {
+    for (int g = 0; g < n; ++g) {
+      r = r * 1103515245u + 12345u;
+      actions[g] = static_cast<std::int32_t>((r >> 16) % 4);
+    }
+    snake_env_step(env, actions.data(), obs.data(), rewards.data(),
+                   dones.data());
+  }
+  state.counters["game_steps/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) * n, benchmark::Counter::kIsRate);
+  snake_env_destroy(env);
+}
+BENCHMARK(BM_EnvStep)->Arg(1024)->Arg(16384);
+
+// Запросы ботов к полю, где змейка длиной в половину поля уложена
+// гамильтоновым циклом: узкие коридоры дают самые длинные волны BFS.
+// Второй аргумент: 0 — битовые строки (kAuto), 1 — очередь (kScalar).
+namespace {
+
+Engine halfFilled(int side) {
+  Engine e{Config{side, side, 42, false, {}, false}};
+  e.dispatch(Event::kStart);
+  const auto target = static_cast<std::size_t>(side * side / 2);
+  while (e.length() < target && e.state() == State::kRunning)
+    cycleTick(e, side, side);
+  return e;
+}
+
+BoardSearch::Mode searchMode(const benchmark::State& state) {
+  return state.range(1) ? BoardSearch::Mode::kScalar : BoardSearch::Mode::kAuto;
+}
+
+}  // namespace
+
+static void BM_ReachableArea(benchmark::State& state) {
+  const Engine e = halfFilled(static_cast<int>(state.range(0)));
+  BoardSearch search(searchMode(state));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(search.reachableArea(e, e.head()));
+  state.counters["area"] = search.reachableArea(e, e.head());
+}
+BENCHMARK(BM_ReachableArea)->ArgsProduct({{20, 64, 100}, {0, 1}});
+
+static void BM_DistanceField(benchmark::State& state) {
+  const Engine e = halfFilled(static_cast<int>(state.range(0)));
+  BoardSearch search(searchMode(state));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(search.distanceField(e, e.head()).data());
+}
+BENCHMARK(BM_DistanceField)->ArgsProduct({{20, 64, 100}, {0, 1}});
+
+// Автопилот на 20x20: решений в секунду и средний счет. Партии
+// доигрываются до конца, включая поиск по следу тела на почти полном
+// поле; лимит тиков — только страховка.
+static void BM_Autopilot(benchmark::State& state) {
+  Autopilot pilot;
+  unsigned seed = 1;
+  double decisions = 0, score = 0, games = 0;
+  for (auto _ : state) {
+    Engine e{Config{20, 20, seed++, false, {}, false}};
+    e.dispatch(Event::kStart);
+    decisions += e.run(1 << 20, pilot).ticks;
+    score += e.snapshot().score;
+    games += 1;
+  }
+  state.counters["decisions/s"] =
+      benchmark::Counter(decisions, benchmark::Counter::kIsRate);
+  state.counters["avg_score"] = score / games;
+}
+BENCHMARK(BM_Autopilot)->Iterations(20)->Unit(benchmark::kMillisecond);
+
+// Предельные длины: CyclePilot доводит партию 100x100 до заданного
+// заполнения (аргумент — промилле поля), дальше меряются шаг, выбор
+// еды и снимок. Партия растет один раз на все бенчмарки: аргументы
+// идут по возрастанию, и каждая следующая доля выращивается из
+// предыдущей.
+namespace {
+
+constexpr int kFillSide = 100;
+
+const CyclePilot& fillPilot() {
+  static const CyclePilot pilot(kFillSide, kFillSide);
+  return pilot;
+}
+
+const Engine& grownGame(int permille) {
+  static Engine growing = [] {
+    Engine e{Config{kFillSide, kFillSide, 42, false, {}, false}};
+    e.dispatch(Event::kStart);
+    return e;
+  }();
+  static std::map<int, Engine> grown;
+  if (auto it = grown.find(permille); it != grown.end()) return it->second;
+  const auto target =
+      static_cast<std::size_t>(kFillSide * kFillSide) * permille / 1000;
+  while (growing.length() < target && growing.freeCells() > 0)
+    (void)growing.run(256, fillPilot());
+  return grown.emplace(permille, growing).first->second;
+}
+
+void fillArgs(benchmark::internal::Benchmark* b) {
+  b->Arg(500)->Arg(900)->Arg(990)->Arg(999);
+}
+
+}  // namespace
+
+// Тик через dispatch(): точечное обновление поля и список изменений
+static void BM_StepAtFill(benchmark::State& state) {
+  const Engine& start = grownGame(static_cast<int>(state.range(0)));
+  Engine e = start;
+  const CyclePilot& pilot = fillPilot();
+  for (auto _ : state) {
+    if (e.state() != State::kRunning || e.freeCells() == 0) {
+      state.PauseTiming();
+      start.cloneInto(e);
+      state.ResumeTiming();
+    }
+    e.dispatch(rules::moveEvent(pilot.decide(e)));
+    e.dispatch(Event::kTick);
+  }
+  state.counters["length"] = static_cast<double>(start.length());
+}
+BENCHMARK(BM_StepAtFill)->Apply(fillArgs);
+
+// Тики внутри Engine::run(): поле не ведется, пилот встраивается;
+// перестройка поля в конце run() делится на 16384 тика
+static void BM_RunAtFill(benchmark::State& state) {
+  const Engine& start = grownGame(static_cast<int>(state.range(0)));
+  Engine e = start;
+  std::int64_t ticks = 0;
+  for (auto _ : state) {
+    if (e.state() != State::kRunning || e.freeCells() == 0) {
+      state.PauseTiming();
+      start.cloneInto(e);
+      state.ResumeTiming();
+    }
+    ticks += e.run(16384, fillPilot()).ticks;
+  }
+  state.SetItemsProcessed(ticks);
+  state.counters["length"] = static_cast<double>(start.length());
+}
+BENCHMARK(BM_RunAtFill)->Apply(fillArgs);
+
+// Engine::spawnFood() закрыт, поэтому меряется его ядро
+// rules::pickFoodCell() на индексе свободных клеток выращенной партии
+static void BM_SpawnFoodAtFill(benchmark::State& state) {
+  const Engine& e = grownGame(static_cast<int>(state.range(0)));
+  const std::span<const std::uint64_t> occ = e.occupancy();
+  auto occupied = [occ](int c) { return (occ[c >> 6] >> (c & 63)) & 1u; };
+  std::vector<int> cells;
+  for (int c = 0; c < kFillSide * kFillSide; ++c)
+    if (!occupied(c)) cells.push_back(c);
+  rules::Rng rng = rules::seedState(1);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(rules::pickFoodCell(
+        rng, cells.data(), static_cast<int>(cells.size())));
+  state.counters["free"] = static_cast<double>(cells.size());
+}
+BENCHMARK(BM_SpawnFoodAtFill)->Apply(fillArgs);
+
+static void BM_SnapshotAtFill(benchmark::State& state) {
+  const Engine& e = grownGame(static_cast<int>(state.range(0)));
+  Snapshot snap;
+  for (auto _ : state) {
+    e.snapshot(snap);
+    benchmark::DoNotOptimize(snap.snake.data());
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          (snap.grid.size() +
+                           snap.snake.size() * sizeof(snap.snake[0])));
+  state.counters["length"] = static_cast<double>(e.length());
+}
+BENCHMARK(BM_SnapshotAtFill)->Apply(fillArgs);
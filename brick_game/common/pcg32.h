@@ -0,0 +1,95 @@
+/**
+ * @file pcg32.h
+ * @brief ГПСЧ PCG32 (XSH RR 64/32) с независимыми потоками и прыжком
+ * @defgroup rng Генератор случайных чисел
+ * @{
+ *
+ * @details
+ * Общий для Snake и Tetris генератор: 64 бита состояния, 32 бита
+ * результата, период 2^64 в каждом из 2^63 потоков. Поток задается
+ * нечетным приращением, поэтому партии с разными stream дают
+ * независимые последовательности при любом seed. pcg32_advance()
+ * перематывает генератор на delta шагов за O(log delta), а
+ * pcg32_bounded() выдает число в [0, n) без смещения остатка
+ * (метод Лемира: умножение 32x32->64 и редкий повтор).
+ *
+ * Все функции static inline: заголовок подключается из C и C++ без
+ * отдельной единицы трансляции.
+ */
+#ifndef BRICK_GAME_PCG32_H
+#define BRICK_GAME_PCG32_H
+#include <stdint.h>
+
+/** @brief Состояние генератора. \ingroup rng */
+typedef struct {
+  uint64_t state; /**< Текущее состояние */
+  uint64_t inc;   /**< Приращение потока (всегда нечетное) */
+} pcg32_t;
+
+/** @brief Множитель LCG из эталонной реализации PCG. \ingroup rng */
+#define PCG32_MULT 6364136223846793005ULL
+
+/** @brief Следующее 32-битное число. \ingroup rng */
+static inline uint32_t pcg32_next(pcg32_t *rng) {
+  uint64_t old = rng->state;
+  rng->state = old * PCG32_MULT + rng->inc;
+  uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+  uint32_t rot = (uint32_t)(old >> 59u);
+  return (xorshifted >> rot) | (xorshifted << ((-rot) & 31u));
+}
+
+/**
+ * @brief Засеять генератор
+ * @param seed Начальное состояние
+ * @param stream Номер потока; разные потоки не пересекаются
+ * \ingroup rng
+ */
+static inline void pcg32_seed(pcg32_t *rng, uint64_t seed, uint64_t stream) {
+  rng->state = 0u;
+  rng->inc = (stream << 1u) | 1u;
+  (void)pcg32_next(rng);
+  rng->state += seed;
+  (void)pcg32_next(rng);
+}
+
+/**
+ * @brief Перемотать генератор вперед на delta шагов за O(log delta)
+ * @details Эквивалентно delta вызовам pcg32_next() без результатов.
+ * \ingroup rng
+ */
+static inline void pcg32_advance(pcg32_t *rng, uint64_t delta) {
+  uint64_t cur_mult = PCG32_MULT, cur_plus = rng->inc;
+  uint64_t acc_mult = 1u, acc_plus = 0u;
+  while (delta > 0) {
+    if (delta & 1u) {
+      acc_mult *= cur_mult;
+      acc_plus = acc_plus * cur_mult + cur_plus;
+    }
+    cur_plus = (cur_mult + 1u) * cur_plus;
+    cur_mult *= cur_mult;
+    delta >>= 1u;
+  }
+  rng->state = acc_mult * rng->state + acc_plus;
+}
+
+/**
+ * @brief Равномерное число в [0, n) без смещения
+ * @param n Верхняя граница (n > 0)
+ * \ingroup rng
+ */
+static inline uint32_t pcg32_bounded(pcg32_t *rng, uint32_t n) {
+  uint64_t m = (uint64_t)pcg32_next(rng) * n;
+  uint32_t low = (uint32_t)m;
+  if (low < n) {
+    // Отбрасываем 2^32 mod n значений, дающих лишний вес младшим числам
+    uint32_t threshold = (0u - n) % n;
+    while (low < threshold) {
+      m = (uint64_t)pcg32_next(rng) * n;
+      low = (uint32_t)m;
+    }
+  }
+  return (uint32_t)(m >> 32);
+}
+
+#endif  // BRICK_GAME_PCG32_H
+/** @} */  // end of group rng
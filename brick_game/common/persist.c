@@ -0,0 +1,400 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "persist.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** @brief Задание очереди: запись, если cb == NULL, иначе чтение */
+typedef struct ps_job {
+  struct ps_job *next;
+  char *path;
+  char *data;
+  size_t len;
+  ps_load_cb cb;
+  void *ctx;
+  ps_slot *slot;  ///< Задание встроено в слот и не освобождается
+} ps_job;
+
+struct ps_slot {
+  ps_job job;  ///< job.data — буфер емкостью cap
+  size_t cap;
+  int queued;  ///< job стоит в очереди
+};
+
+static struct {
+  pthread_mutex_t mu;
+  pthread_cond_t work;  ///< Появилось задание или запрошена остановка
+  pthread_cond_t idle;  ///< Очередь пуста и поток ничего не делает
+  ps_job *head, *tail;
+  int busy;     ///< Поток выполняет задание вне очереди
+  int running;  ///< Поток запущен
+  int stop;     ///< Запрошена остановка
+  int atexit_set;
+  pthread_t thread;
+} g_ps = {.mu = PTHREAD_MUTEX_INITIALIZER,
+          .work = PTHREAD_COND_INITIALIZER,
+          .idle = PTHREAD_COND_INITIALIZER};
+
+/// Номер временного файла: синхронная запись может совпасть по пути с
+/// фоновой, а pid у них общий
+static atomic_ulong g_tmp_seq;
+
+static char *ps_strdup(const char *s) {
+  size_t n = strlen(s) + 1;
+  char *r = malloc(n);
+  if (r) memcpy(r, s, n);
+  return r;
+}
+
+static void ps_free_job(ps_job *j) {
+  free(j->path);
+  free(j->data);
+  free(j);
+}
+
+static void ps_make_parents(const char *path) {
+  char *buf = ps_strdup(path);
+  if (!buf) return;
+  for (char *p = buf + 1; *p; ++p) {
+    if (*p != '/') continue;
+    *p = '\0';
+    (void)mkdir(buf, 0755);
+    *p = '/';
+  }
+  free(buf);
+}
+
+static int ps_write_all(int fd, const char *data, size_t len) {
+  while (len > 0) {
+    ssize_t n = write(fd, data, len);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return -1;
+    }
+    data += n;
+    len -= (size_t)n;
+  }
+  return 0;
+}
+
+int ps_write_atomic(const char *path, const void *data, size_t len) {
+  if (!path || !*path || (!data && len)) {
+    errno = EINVAL;
+    return -1;
+  }
+  // Устройства, каналы и ссылки нельзя подменять через rename():
+  // в них пишем на месте, как обычный fopen("w")
+  struct stat st;
+  if (lstat(path, &st) == 0 && !S_ISREG(st.st_mode)) {
+    int fd = open(path, O_WRONLY | O_TRUNC);
+    if (fd < 0) return -1;
+    int rc = ps_write_all(fd, data, len);
+    if (close(fd) != 0) rc = -1;
+    return rc;
+  }
+
+  size_t tmp_len = strlen(path) + 48;
+  char *tmp = malloc(tmp_len);
+  if (!tmp) return -1;
+  snprintf(tmp, tmp_len, "%s.%ld.%lu.tmp", path, (long)getpid(),
+           atomic_fetch_add(&g_tmp_seq, 1));
+
+  ps_make_parents(path);
+  int rc = -1;
+  int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd >= 0) {
+    rc = ps_write_all(fd, data, len);
+    if (rc == 0) rc = fsync(fd);
+    if (close(fd) != 0) rc = -1;
+    if (rc == 0) rc = rename(tmp, path);
+    if (rc != 0) {
+      int saved = errno;
+      (void)unlink(tmp);
+      errno = saved;
+    }
+  }
+  free(tmp);
+  return rc;
+}
+
+static void ps_run_load(const ps_job *j) {
+  FILE *f = fopen(j->path, "rb");
+  if (!f) {
+    j->cb(j->ctx, NULL, 0, errno == ENOENT ? 0 : -1);
+    return;
+  }
+  char *buf = NULL;
+  size_t len = 0, cap = 0;
+  int ok = 1;
+  for (;;) {
+    if (len == cap) {
+      size_t ncap = cap ? cap * 2 : 256;
+      char *nbuf = realloc(buf, ncap);
+      if (!nbuf) {
+        ok = 0;
+        break;
+      }
+      buf = nbuf;
+      cap = ncap;
+    }
+    size_t n = fread(buf + len, 1, cap - len, f);
+    len += n;
+    if (n == 0) {
+      if (ferror(f)) ok = 0;
+      break;
+    }
+  }
+  fclose(f);
+  j->cb(j->ctx, ok ? buf : NULL, ok ? len : 0, ok ? 1 : -1);
+  free(buf);
+}
+
+static void ps_run_job(ps_job *j) {
+  if (j->cb)
+    ps_run_load(j);
+  else
+    (void)ps_write_atomic(j->path, j->data, j->len);
+  ps_free_job(j);
+}
+
+/**
+ * @brief Забрать задание из очереди (под мьютексом)
+ * @details Данные слота копируются: владелец может писать в слот,
+ * пока запись идет на диск. Копия выделяется в рабочем потоке.
+ * @return Задание для ps_run_job() или NULL, если памяти не хватило
+ */
+static ps_job *ps_take_locked(ps_job *j) {
+  if (!j->slot) return j;
+  j->slot->queued = 0;
+  ps_job *copy = calloc(1, sizeof *copy);
+  if (copy) {
+    copy->path = ps_strdup(j->path);
+    copy->data = malloc(j->len ? j->len : 1);
+    copy->len = j->len;
+  }
+  if (!copy || !copy->path || !copy->data) {
+    if (copy) ps_free_job(copy);
+    return NULL;
+  }
+  memcpy(copy->data, j->data, j->len);
+  return copy;
+}
+
+static void *ps_worker(void *arg) {
+  (void)arg;
+  pthread_mutex_lock(&g_ps.mu);
+  for (;;) {
+    while (!g_ps.head && !g_ps.stop) pthread_cond_wait(&g_ps.work, &g_ps.mu);
+    if (!g_ps.head) break;
+
+    ps_job *j = g_ps.head;
+    g_ps.head = j->next;
+    if (!g_ps.head) g_ps.tail = NULL;
+    j = ps_take_locked(j);
+    g_ps.busy = 1;
+    pthread_mutex_unlock(&g_ps.mu);
+
+    if (j) ps_run_job(j);
+
+    pthread_mutex_lock(&g_ps.mu);
+    g_ps.busy = 0;
+    if (!g_ps.head) pthread_cond_broadcast(&g_ps.idle);
+  }
+  pthread_mutex_unlock(&g_ps.mu);
+  return NULL;
+}
+
+/**
+ * @brief Поставить задание в очередь (под мьютексом)
+ * @return 0; -1, если поток не запустился — тогда задание выполняет
+ *         вызывающий поток после разблокировки
+ */
+static int ps_enqueue_locked(ps_job *j) {
+  if (!g_ps.running) {
+    if (pthread_create(&g_ps.thread, NULL, ps_worker, NULL) != 0) return -1;
+    g_ps.running = 1;
+    if (!g_ps.atexit_set) g_ps.atexit_set = atexit(ps_shutdown) == 0;
+  }
+  if (g_ps.tail)
+    g_ps.tail->next = j;
+  else
+    g_ps.head = j;
+  g_ps.tail = j;
+  pthread_cond_signal(&g_ps.work);
+  return 0;
+}
+
+static void ps_submit(ps_job *j) {
+  pthread_mutex_lock(&g_ps.mu);
+  int rc = ps_enqueue_locked(j);
+  pthread_mutex_unlock(&g_ps.mu);
+  if (rc == 0) return;
+
+  // Без потока задание выполняется на месте: медленнее, но не теряется
+  ps_run_job(j);
+}
+
+int ps_load_async(const char *path, ps_load_cb cb, void *ctx) {
+  if (!path || !*path || !cb) {
+    errno = EINVAL;
+    return -1;
+  }
+  ps_job *j = calloc(1, sizeof *j);
+  if (!j) return -1;
+  j->path = ps_strdup(path);
+  if (!j->path) {
+    free(j);
+    return -1;
+  }
+  j->cb = cb;
+  j->ctx = ctx;
+  ps_submit(j);
+  return 0;
+}
+
+int ps_write_async(const char *path, const void *data, size_t len) {
+  if (!path || !*path || (!data && len)) {
+    errno = EINVAL;
+    return -1;
+  }
+  char *copy = malloc(len ? len : 1);
+  if (!copy) return -1;
+  if (len) memcpy(copy, data, len);
+
+  // Схлопывается только последнее задание этого пути, если это запись:
+  // чтение после нее должно увидеть ее содержимое, а не более позднее
+  pthread_mutex_lock(&g_ps.mu);
+  ps_job *last = NULL;
+  for (ps_job *q = g_ps.head; q; q = q->next)
+    if (strcmp(q->path, path) == 0) last = q;
+  if (last && !last->cb && !last->slot) {
+    free(last->data);
+    last->data = copy;
+    last->len = len;
+    pthread_mutex_unlock(&g_ps.mu);
+    return 0;
+  }
+  pthread_mutex_unlock(&g_ps.mu);
+
+  ps_job *j = calloc(1, sizeof *j);
+  if (j) j->path = ps_strdup(path);
+  if (!j || !j->path) {
+    free(j);
+    free(copy);
+    return -1;
+  }
+  j->data = copy;
+  j->len = len;
+  ps_submit(j);
+  return 0;
+}
+
+ps_slot *ps_slot_create(const char *path, size_t capacity) {
+  if (!path || !*path) {
+    errno = EINVAL;
+    return NULL;
+  }
+  ps_slot *s = calloc(1, sizeof *s);
+  if (!s) return NULL;
+  s->job.path = ps_strdup(path);
+  s->job.data = malloc(capacity ? capacity : 1);
+  if (!s->job.path || !s->job.data) {
+    free(s->job.path);
+    free(s->job.data);
+    free(s);
+    return NULL;
+  }
+  s->job.slot = s;
+  s->cap = capacity;
+  return s;
+}
+
+int ps_slot_write(ps_slot *s, const void *data, size_t len) {
+  if (!s || (!data && len) || len > s->cap) {
+    errno = EINVAL;
+    return -1;
+  }
+  pthread_mutex_lock(&g_ps.mu);
+  ps_job *last = NULL;
+  for (ps_job *q = g_ps.head; q; q = q->next)
+    if (strcmp(q->path, s->job.path) == 0) last = q;
+  // Слот уже в очереди и за ним нет заданий этого пути: хватает новых
+  // данных. Если за ним чтение, слот нельзя переставить — тогда обычное
+  // задание с копией
+  if (s->queued && last != &s->job) {
+    pthread_mutex_unlock(&g_ps.mu);
+    return ps_write_async(s->job.path, data, len);
+  }
+  if (len) memcpy(s->job.data, data, len);
+  s->job.len = len;
+  int rc = 0;
+  if (!s->queued) {
+    s->job.next = NULL;
+    rc = ps_enqueue_locked(&s->job);
+    if (rc == 0) s->queued = 1;
+  }
+  pthread_mutex_unlock(&g_ps.mu);
+  if (rc == 0) return 0;
+
+  // Без потока запись выполняется на месте
+  return ps_write_atomic(s->job.path, data, len);
+}
+
+void ps_slot_destroy(ps_slot *s) {
+  if (!s) return;
+  ps_flush();
+  free(s->job.path);
+  free(s->job.data);
+  free(s);
+}
+
+void ps_flush(void) {
+  pthread_mutex_lock(&g_ps.mu);
+  while (g_ps.running && (g_ps.head || g_ps.busy))
+    pthread_cond_wait(&g_ps.idle, &g_ps.mu);
+  pthread_mutex_unlock(&g_ps.mu);
+}
+
+void ps_shutdown(void) {
+  pthread_mutex_lock(&g_ps.mu);
+  if (!g_ps.running) {
+    pthread_mutex_unlock(&g_ps.mu);
+    return;
+  }
+  g_ps.stop = 1;
+  pthread_cond_signal(&g_ps.work);
+  pthread_mutex_unlock(&g_ps.mu);
+
+  pthread_join(g_ps.thread, NULL);
+
+  // Задания, поставленные после выхода потока, выполняются здесь
+  pthread_mutex_lock(&g_ps.mu);
+  ps_job *rest = NULL, **rest_tail = &rest;
+  for (ps_job *q = g_ps.head, *next; q; q = next) {
+    next = q->next;
+    ps_job *j = ps_take_locked(q);
+    if (!j) continue;
+    j->next = NULL;
+    *rest_tail = j;
+    rest_tail = &j->next;
+  }
+  g_ps.head = g_ps.tail = NULL;
+  g_ps.running = 0;
+  g_ps.stop = 0;
+  pthread_cond_broadcast(&g_ps.idle);
+  pthread_mutex_unlock(&g_ps.mu);
+
+  while (rest) {
+    ps_job *j = rest;
+    rest = j->next;
+    ps_run_job(j);
+  }
+}
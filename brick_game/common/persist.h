@@ -0,0 +1,107 @@
+/**
+ * @file persist.h
+ * @brief Фоновое сохранение небольших файлов (рекорды Snake и Tetris)
+ * @defgroup persist Фоновое сохранение
+ * @{
+ *
+ * @details
+ * Один рабочий поток обслуживает очередь заданий чтения и записи, так
+ * что игровой поток не ждет диска. Повторные записи в один и тот же
+ * путь, еще не взятые в работу и не разделенные чтением этого пути,
+ * схлопываются: на диск попадает только последнее содержимое. Запись
+ * атомарна — данные пишутся во временный файл рядом с целевым и
+ * подменяют его через rename(), поэтому читатель никогда не увидит
+ * обрезанный файл. Устройства (/dev/null), каналы и символические
+ * ссылки не подменяются, а пишутся на месте.
+ *
+ * Задания выполняются в порядке постановки: чтение, поставленное
+ * раньше записи того же пути, видит старое содержимое файла.
+ * Поток запускается при первом задании и останавливается ps_shutdown()
+ * (она же регистрируется через atexit()).
+ */
+#ifndef BRICK_GAME_PERSIST_H
+#define BRICK_GAME_PERSIST_H
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Результат чтения файла; вызывается из рабочего потока
+ * @param ctx Контекст, переданный в ps_load_async()
+ * @param data Содержимое файла (действительно только во время вызова)
+ * @param len Длина содержимого
+ * @param found 1 — файл прочитан, 0 — файла нет, -1 — ошибка чтения
+ * \ingroup persist
+ */
+typedef void (*ps_load_cb)(void *ctx, const char *data, size_t len,
+                           int found);
+
+/**
+ * @brief Прочитать файл в фоне
+ * @return 0 или -1 (errno), если задание не поставлено
+ * \ingroup persist
+ */
+int ps_load_async(const char *path, ps_load_cb cb, void *ctx);
+
+/**
+ * @brief Поставить атомарную запись файла; данные копируются
+ * @details Еще не начатая запись того же пути заменяется новой, если
+ * после нее нет чтения этого пути.
+ * @return 0 или -1 (errno), если задание не поставлено
+ * \ingroup persist
+ */
+int ps_write_async(const char *path, const void *data, size_t len);
+
+/**
+ * @brief Синхронная атомарная запись: временный файл + rename()
+ * @details Недостающие родительские каталоги создаются. Временный файл
+ * у каждого вызова свой, поэтому вызов безопасен параллельно с фоновой
+ * записью того же пути.
+ * @return 0 или -1 (errno)
+ * \ingroup persist
+ */
+int ps_write_atomic(const char *path, const void *data, size_t len);
+
+/**
+ * @brief Слот записи: путь и буфер, выделенные заранее
+ * @details Для частых маленьких записей с потока, который не должен
+ * выделять память (рекорд на тике Game Over).
+ * \ingroup persist
+ */
+typedef struct ps_slot ps_slot;
+
+/**
+ * @brief Создать слот записи файла path емкостью capacity байт
+ * @return Слот или NULL (errno)
+ * \ingroup persist
+ */
+ps_slot *ps_slot_create(const char *path, size_t capacity);
+
+/**
+ * @brief Поставить запись содержимого слота, как ps_write_async()
+ * @details Данные копируются в буфер слота; пока слот ждет в очереди,
+ * новая запись только заменяет данные. Память выделяется лишь в
+ * редком случае, когда после слота в очереди стоит чтение того же
+ * пути.
+ * @return 0 или -1 (errno): len больше емкости или задание не поставлено
+ * \ingroup persist
+ */
+int ps_slot_write(ps_slot *s, const void *data, size_t len);
+
+/** @brief Дождаться записи слота и освободить его \ingroup persist */
+void ps_slot_destroy(ps_slot *s);
+
+/** @brief Дождаться выполнения всех поставленных заданий \ingroup persist */
+void ps_flush(void);
+
+/** @brief Выполнить задания и остановить рабочий поток \ingroup persist */
+void ps_shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICK_GAME_PERSIST_H
+/** @} */  // end of group persist
@@ -0,0 +1,303 @@
+#include "autopilot.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "rules.h"
+
+namespace s21::snake {
+
+namespace {
+
+constexpr Direction kDirs[] = {Direction::kUp, Direction::kDown,
+                               Direction::kLeft, Direction::kRight};
+
+Direction opposite(Direction d) {
+  switch (d) {
+    case Direction::kUp:
+      return Direction::kDown;
+    case Direction::kDown:
+      return Direction::kUp;
+    case Direction::kLeft:
+      return Direction::kRight;
+    case Direction::kRight:
+      break;
+  }
+  return Direction::kLeft;
+}
+
+// Куча по возрастанию f, при равных f — по возрастанию эвристики
+bool later(const auto& a, const auto& b) {
+  return a.f > b.f || (a.f == b.f && a.h > b.h);
+}
+
+}  // namespace
+
+void Autopilot::prepare(const Engine& e) {
+  const std::size_t cells = static_cast<std::size_t>(e.width()) * e.height();
+  if (seen_.size() != cells) {
+    // Метки от поля другого размера бессмысленны: начинаем заново
+    seen_.assign(cells, 0);
+    g_.resize(cells);
+    from_.resize(cells);
+    free_at_.resize(cells);
+    open_.reserve(4 * cells);
+    path_.reserve(cells + 1);
+    plan_.reserve(cells + 1);
+    stamp_ = 0;
+  }
+  w_ = e.width();
+  h_ = e.height();
+  wrap_ = e.wrap();
+  occ_ = e.occupancy().data();
+  const Point t = e.tail();
+  tail_ = t.y * w_ + t.x;
+}
+
+int Autopilot::neighbor(int i, Direction d) const {
+  int x = i % w_ + rules::deltaX(d), y = i / w_ + rules::deltaY(d);
+  if (wrap_) {
+    x = rules::wrapCoord(x, w_, 0);
+    y = rules::wrapCoord(y, h_, 0);
+  } else if (x < 0 || x >= w_ || y < 0 || y >= h_) {
+    return -1;
+  }
+  return y * w_ + x;
+}
+
+int Autopilot::heuristic(int a, int b) const {
+  int dx = std::abs(a % w_ - b % w_), dy = std::abs(a / w_ - b / w_);
+  if (wrap_) {
+    dx = std::min(dx, w_ - dx);
+    dy = std::min(dy, h_ - dy);
+  }
+  return dx + dy;
+}
+
+Direction Autopilot::stepTo(int from, int to) const {
+  for (Direction d : kDirs)
+    if (neighbor(from, d) == to) return d;
+  return Direction::kRight;
+}
+
+bool Autopilot::findPath(const Engine& e, int target, int margin) {
+  const Point head = e.head();
+  const int start = head.y * w_ + head.x;
+  if (++stamp_ == 0) {
+    std::fill(seen_.begin(), seen_.end(), 0);
+    stamp_ = 1;
+  }
+  open_.clear();
+  seen_[start] = stamp_;
+  g_[start] = 0;
+  const int h0 = heuristic(start, target);
+  open_.push_back({h0, h0, start});
+
+  while (!open_.empty()) {
+    std::pop_heap(open_.begin(), open_.end(), later<Node, Node>);
+    const Node n = open_.back();
+    open_.pop_back();
+    // Клетку уже достали с меньшим g: запись устарела
+    if (n.f - n.h != g_[n.cell]) continue;
+    if (n.cell == target) break;
+    for (Direction d : kDirs) {
+      // Разворот на 180° движок игнорирует
+      if (n.cell == start && rules::isOpposite(e.direction(), d)) continue;
+      const int j = neighbor(n.cell, d);
+      if (j < 0) continue;
+      const int g = g_[n.cell] + 1;
+      // С запасом margin клетка тела проходима, когда уже освободилась
+      if (margin < 0 ? !passable(j)
+                     : free_at_[j] != 0 && free_at_[j] + margin > g)
+        continue;
+      if (seen_[j] == stamp_ && g_[j] <= g) continue;
+      seen_[j] = stamp_;
+      g_[j] = g;
+      from_[j] = static_cast<std::uint8_t>(d);
+      const int h = heuristic(j, target);
+      open_.push_back({g + h, h, j});
+      std::push_heap(open_.begin(), open_.end(), later<Node, Node>);
+    }
+  }
+  if (seen_[target] != stamp_ || target == start) return false;
+
+  path_.clear();
+  for (int c = target; c != start;
+       c = neighbor(c, opposite(static_cast<Direction>(from_[c]))))
+    path_.push_back(c);
+  std::reverse(path_.begin(), path_.end());
+  return true;
+}
+
+void Autopilot::extendPath(int start, Direction dir) {
+  // Клетки пути, включая начальную, помечаются новым stamp_
+  if (++stamp_ == 0) {
+    std::fill(seen_.begin(), seen_.end(), 0);
+    stamp_ = 1;
+  }
+  path_.insert(path_.begin(), start);
+  for (int c : path_) seen_[c] = stamp_;
+
+  for (std::size_t i = 0; i + 1 < path_.size();) {
+    const int a = path_[i], b = path_[i + 1];
+    const Direction step = stepTo(a, b);
+    const bool vertical = rules::deltaX(step) == 0;
+    const Direction sides[2] = {
+        vertical ? Direction::kLeft : Direction::kUp,
+        vertical ? Direction::kRight : Direction::kDown};
+    bool extended = false;
+    for (Direction side : sides) {
+      if (i == 0 && rules::isOpposite(dir, side)) continue;
+      const int a2 = neighbor(a, side), b2 = neighbor(b, side);
+      if (a2 < 0 || b2 < 0 || !passable(a2) || !passable(b2) ||
+          seen_[a2] == stamp_ || seen_[b2] == stamp_)
+        continue;
+      // a -> b становится a -> a2 -> b2 -> b
+      const int detour[] = {a2, b2};
+      path_.insert(path_.begin() + static_cast<std::ptrdiff_t>(i) + 1,
+                   detour, detour + 2);
+      seen_[a2] = seen_[b2] = stamp_;
+      extended = true;
+      break;
+    }
+    if (!extended) ++i;
+  }
+  path_.erase(path_.begin());
+}
+
+bool Autopilot::safeAfter(const Engine& e, int steps, Check check) {
+  e.cloneInto(sim_);
+  int k = 0;
+  (void)sim_.run(steps, [&](const Engine& s) {
+    const Point h = s.head();
+    return stepTo(h.y * w_ + h.x, path_[k++]);
+  });
+  if (sim_.state() != State::kRunning) return false;
+  if (sim_.freeCells() == 0) return true;
+  switch (check) {
+    case Check::kTail:
+      return search_.distance(sim_, sim_.head(), sim_.tail()) >= 0;
+    case Check::kTrail:
+      return escapes(sim_);
+    case Check::kAlive:
+      break;
+  }
+  return true;
+}
+
+void Autopilot::loadTrail(const Engine& s) {
+  std::fill(free_at_.begin(), free_at_.end(), 0);
+  const BodyView body = s.view().snake;
+  const int len = static_cast<int>(body.size());
+  for (int i = 0; i < len; ++i)
+    free_at_[body[i].y * w_ + body[i].x] = len - i;
+}
+
+bool Autopilot::escapes(const Engine& s) {
+  loadTrail(s);
+  if (++stamp_ == 0) {
+    std::fill(seen_.begin(), seen_.end(), 0);
+    stamp_ = 1;
+  }
+  // BFS по свободным клеткам; f узла — тик, на котором голова в клетке.
+  // Клетка тела, освободившаяся к приходу головы, — выход на след тела:
+  // дальше голова идет за хвостом
+  const Point head = s.head();
+  const int start = head.y * w_ + head.x;
+  open_.clear();
+  open_.push_back({0, 0, start});
+  seen_[start] = stamp_;
+  for (std::size_t q = 0; q < open_.size(); ++q) {
+    const Node n = open_[q];
+    for (Direction d : kDirs) {
+      const int j = neighbor(n.cell, d);
+      if (j < 0 || seen_[j] == stamp_) continue;
+      if (free_at_[j] == 0) {
+        seen_[j] = stamp_;
+        open_.push_back({n.f + 1, 0, j});
+      } else if (free_at_[j] <= n.f + 1) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+Direction Autopilot::decide(const Engine& e) {
+  prepare(e);
+  const Point head = e.head();
+  const int start = head.y * w_ + head.x;
+  // Рост или новая партия обнуляют счетчик застоя
+  if (e.length() != grown_at_) {
+    grown_at_ = e.length();
+    stall_ = 0;
+    plan_.clear();
+  } else {
+    ++stall_;
+  }
+  // Принятый путь по следу тела уже проверен до самой еды; на следующем
+  // тике поиск может найти другой, поэтому идем по сохраненному
+  if (plan_at_ < plan_.size() && start == plan_head_) {
+    plan_head_ = plan_[plan_at_++];
+    return stepTo(start, plan_head_);
+  }
+  plan_.clear();
+
+  const auto [fx, fy] = e.food();
+  if (fx >= 0 && findPath(e, fy * w_ + fx) &&
+      safeAfter(e, static_cast<int>(path_.size())))
+    return stepTo(start, path_[0]);
+
+  // Погоня за хвостом периодична: раскладка тела повторяется, и путь к
+  // еде так и не становится безопасным. После обхода поля без роста
+  // путь к еде ищется по следу тела с учетом того, когда освободятся
+  // его клетки. Запас в тик нужен, чтобы выйти из кармана с едой: рост
+  // задерживает хвост. После второго обхода остается проверить лишь,
+  // что змейка переживет саму еду, — партия доигрывается, а не упирается
+  // в лимит тиков
+  if (stall_ > w_ * h_ && fx >= 0) {
+    const bool last_resort = stall_ > 2 * w_ * h_;
+    loadTrail(e);
+    if (findPath(e, fy * w_ + fx, last_resort ? 0 : 1) &&
+        safeAfter(e, static_cast<int>(path_.size()),
+                  last_resort ? Check::kAlive : Check::kTrail)) {
+      plan_.assign(path_.begin(), path_.end());
+      plan_at_ = 1;
+      plan_head_ = path_[0];
+      return stepTo(start, path_[0]);
+    }
+  }
+
+  const Point t = e.tail();
+  if (e.length() > 1 && findPath(e, t.y * w_ + t.x)) {
+    extendPath(start, e.direction());
+    if (safeAfter(e, 1)) return stepTo(start, path_[0]);
+  }
+
+  // Хвост недостижим: ход, после которого свободнее всего
+  Direction best = e.direction();
+  int best_area = -1;
+  for (Direction d : kDirs) {
+    if (rules::isOpposite(e.direction(), d)) continue;
+    const int n = neighbor(start, d);
+    if (n < 0 || !passable(n)) continue;
+    e.cloneInto(sim_);
+    (void)sim_.run(1, [d](const Engine&) { return d; });
+    if (sim_.state() != State::kRunning) continue;
+    const int area = search_.reachableArea(sim_, sim_.head());
+    if (area > best_area) {
+      best = d;
+      best_area = area;
+    }
+  }
+  return best;
+}
+
+Policy autopilotPolicy() {
+  return [](const Engine& e) {
+    thread_local Autopilot pilot;
+    return pilot.decide(e);
+  };
+}
+
+}  // namespace s21::snake
@@ -0,0 +1,125 @@
+/**
+ * @file autopilot.h
+ * @brief Автопилот Snake: A* к еде с проверкой достижимости хвоста
+ * @author BrickGame Team
+ * @version 2.0
+ * @date 2024
+ *
+ * @details
+ * Каждый ход Autopilot::decide() ищет A* кратчайший путь от головы к
+ * еде по битовой карте змейки движка (Engine::occupancy()); хвост
+ * проходим, потому что без роста освобождается в тот же тик. Путь
+ * принимается, только если на копии движка после его прохода голова
+ * все еще может дойти до хвоста: пока хвост достижим, змейка не
+ * запрет себя.
+ *
+ * Если безопасного пути к еде нет, автопилот тянет время: строит путь
+ * к хвосту и удлиняет его обходами (пара соседних клеток пути
+ * заменяется петлей через две свободные клетки), затем делает первый
+ * ход этого самого длинного найденного пути, если после него хвост
+ * достижим. Когда нет и его, выбирается ход с наибольшей доступной
+ * областью (BoardSearch).
+ *
+ * На почти полном поле погоня за хвостом ходит по одной петле, и еда в
+ * кармане тела остается недоступной навсегда. Поэтому после width *
+ * height решений без роста путь к еде ищется по следу тела: клетка,
+ * которую хвост освободит через k тиков, проходима с k + 1 шага. Путь
+ * принимается, если из кармана с едой голова выйдет на освободившийся
+ * след, и доводится до конца без пересчета. После второго такого срока
+ * достаточно пережить саму еду: партия заканчивается, а не упирается в
+ * лимит тиков.
+ *
+ * Решение зависит только от состояния партии и ходов после последнего
+ * роста, поэтому прогон с автопилотом воспроизводим. Рабочие массивы и
+ * копия движка живут в объекте: после первого хода на поле того же
+ * размера решения не выделяют память. Один объект нельзя вызывать из
+ * нескольких потоков; для runGames() есть autopilotPolicy().
+ */
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "backend.h"
+#include "runner.h"
+#include "search.h"
+
+namespace s21::snake {
+
+/**
+ * @class Autopilot
+ * @brief Сильный детерминированный игрок для нагрузочных прогонов
+ */
+class Autopilot {
+ public:
+  /**
+   * @brief Ход на следующий тик
+   * @param e Партия в состоянии kRunning
+   * @return Направление; текущее, если безопасных ходов нет
+   */
+  Direction decide(const Engine& e);
+
+  /** @brief То же: объект служит стратегией для Engine::run() */
+  Direction operator()(const Engine& e) { return decide(e); }
+
+ private:
+  /**
+   * @struct Node
+   * @brief Элемент открытого списка A*
+   */
+  struct Node {
+    int f;     ///< g + эвристика
+    int h;     ///< Эвристика: при равных f ближе к цели — раньше
+    int cell;  ///< Индекс клетки
+  };
+
+  /**
+   * @enum Check
+   * @brief Что проверить в конце пути
+   */
+  enum class Check {
+    kTail,   ///< Голова дойдет до хвоста
+    kTrail,  ///< Голова выйдет на освобождающийся след тела
+    kAlive   ///< Змейка жива
+  };
+
+  BoardSearch search_;
+  Engine sim_{Config{20, 20, 0, false, {}, false}};  ///< Копия для проверок
+  int w_{0}, h_{0};                 ///< Размер поля текущего решения
+  bool wrap_{false};                ///< Поле-тор
+  const std::uint64_t* occ_{nullptr};  ///< Битовая карта змейки
+  int tail_{-1};                    ///< Хвост: проходим в поиске
+  std::uint32_t stamp_{0};          ///< Номер текущего поиска
+  std::vector<std::uint32_t> seen_;  ///< Клетка открыта в поиске stamp_
+  std::vector<int> g_;              ///< Длина пути до клетки
+  std::vector<std::uint8_t> from_;  ///< Направление входа в клетку
+  std::vector<Node> open_;          ///< Куча открытого списка
+  std::vector<int> path_;           ///< Клетки пути без начальной
+  std::vector<int> free_at_;        ///< Через сколько тиков клетка свободна
+  std::size_t grown_at_{0};         ///< Длина змейки на последнем росте
+  int stall_{0};                    ///< Решений без роста подряд
+  std::vector<int> plan_;           ///< Принятый путь по следу тела
+  std::size_t plan_at_{0};          ///< Следующая клетка plan_
+  int plan_head_{-1};               ///< Где должна быть голова сейчас
+
+  void prepare(const Engine& e);
+  bool passable(int i) const {
+    return i == tail_ || !((occ_[i >> 6] >> (i & 63)) & 1u);
+  }
+  int neighbor(int i, Direction d) const;
+  int heuristic(int a, int b) const;
+  bool findPath(const Engine& e, int target, int margin = -1);
+  void extendPath(int start, Direction dir);
+  Direction stepTo(int from, int to) const;
+  bool safeAfter(const Engine& e, int steps, Check check = Check::kTail);
+  void loadTrail(const Engine& s);
+  bool escapes(const Engine& s);
+};
+
+/**
+ * @brief Стратегия с автопилотом для runGames() и playGame()
+ * @details У каждого потока свой Autopilot (thread_local).
+ */
+Policy autopilotPolicy();
+
+}  // namespace s21::snake
@@ -1,12 +1,86 @@
+#include <algorithm>
+#include <cstdio>
 #include <cstdlib>
-#include <filesystem>
-#include <fstream>
+#include <iterator>
+#include <limits>
 #include <random>
 #include <stdexcept>
 
+#include "../common/persist.h"
 #include "backend.h"
+#include "rules.h"
+#include "varint.h"
 namespace s21::snake {
 
+FileBestStore::FileBestStore(std::string path) : path_(std::move(path)) {
+  // Рекорд — не больше 11 символов и перевод строки
+  slot_ = ps_slot_create(path_.c_str(), 16);
+  if (ps_load_async(path_.c_str(), &FileBestStore::onLoaded, this) != 0)
+    loaded_ = true;
+}
+
+FileBestStore::~FileBestStore() {
+  // Обратный вызов чтения ссылается на this
+  {
+    std::unique_lock lock(mu_);
+    loaded_cv_.wait(lock, [this] { return loaded_; });
+  }
+  if (slot_)
+    ps_slot_destroy(slot_);
+  else
+    ps_flush();
+}
+
+void FileBestStore::onLoaded(void* ctx, const char* data, std::size_t len,
+                             int found) {
+  auto* self = static_cast<FileBestStore*>(ctx);
+  int v = 0;
+  if (found && data) {
+    const std::string text(data, len);
+    const long parsed = std::strtol(text.c_str(), nullptr, 10);
+    v = parsed < 0 || parsed > std::numeric_limits<int>::max()
+            ? 0
+            : static_cast<int>(parsed);
+  }
+  std::lock_guard lock(self->mu_);
+  if (self->dirty_ && self->best_ > v) self->writeLocked();
+  self->best_ = std::max(self->best_, v);
+  self->dirty_ = false;
+  self->loaded_ = true;
+  self->loaded_cv_.notify_all();
+}
+
+int FileBestStore::load() {
+  std::unique_lock lock(mu_);
+  loaded_cv_.wait(lock, [this] { return loaded_; });
+  return best_;
+}
+
+bool FileBestStore::ready() {
+  std::lock_guard lock(mu_);
+  return loaded_;
+}
+
+void FileBestStore::save(int best) {
+  std::lock_guard lock(mu_);
+  if (best <= best_) return;
+  best_ = best;
+  if (loaded_)
+    writeLocked();
+  else
+    dirty_ = true;
+}
+
+void FileBestStore::writeLocked() {
+  char buf[16];
+  const int n = std::snprintf(buf, sizeof buf, "%d\n", best_);
+  if (n <= 0) return;
+  if (slot_)
+    (void)ps_slot_write(slot_, buf, static_cast<std::size_t>(n));
+  else
+    (void)ps_write_async(path_.c_str(), buf, static_cast<std::size_t>(n));
+}
+
 Engine::~Engine() {
   recomputeLevelAndSpeed();
   UpdateBest();
@@ -15,38 +89,230 @@ Engine::~Engine() {
 Engine::Engine(Config cfg) : cfg_(cfg) {
   if (cfg_.width <= 3 || cfg_.height <= 3)
     throw std::invalid_argument("Board too small");
-
-  best_path_ = cfg_.best_path.empty() ? defaultBestPath() : cfg_.best_path;
-  best_ = loadBestFromFile(best_path_);
+  if (cfg_.width > std::numeric_limits<Coord>::max() ||
+      cfg_.height > std::numeric_limits<Coord>::max())
+    throw std::invalid_argument("Board too large");
+
+  wrap_mask_x_ = rules::wrapMask(W());
+  wrap_mask_y_ = rules::wrapMask(H());
+  // Без сохранения движок не читает окружение и файлы вовсе
+  persist_ = cfg_.persist;
+  best_store_ = cfg_.best_store;
+  if (persist_ && !best_store_) {
+    own_store_ = std::make_unique<FileBestStore>(
+        cfg_.best_path.empty() ? defaultBestPath() : cfg_.best_path);
+  }
+  // Файл читается в фоне: рекорд подхватит kStart, если чтение не успело
+  if (BestStore* s = persist_ ? store() : nullptr; s && s->ready())
+    best_ = s->load();
 
   grid_.assign(W() * H(), Cell::kEmpty);
+  occupied_.assign((W() * H() + 63) / 64, 0);
+  free_cells_.assign(W() * H(), 0);
+  free_pos_.assign(W() * H(), -1);
+  snake_.reset(W() * H());
   placeInitialSnake();
 
-  rng_state_ = cfg_.seed ? cfg_.seed : 0x9E3779B9u;
+  rng_state_ = rules::seedState(cfg_.seed);
   spawnFood();
   applySnakeToGrid();
 }
 
-State Engine::state() const { return state_; }
+Engine::Engine(const Engine& other)
+    : cfg_{other.cfg_.width, other.cfg_.height, other.cfg_.seed,
+           other.cfg_.wrap, {}, false, nullptr},
+      persist_(false) {
+  other.cloneInto(*this);
+}
 
-bool Engine::isOpposite(Direction a, Direction b) const {
-  return (a == Direction::kLeft && b == Direction::kRight) ||
-         (a == Direction::kRight && b == Direction::kLeft) ||
-         (a == Direction::kUp && b == Direction::kDown) ||
-         (a == Direction::kDown && b == Direction::kUp);
+Engine& Engine::operator=(const Engine& other) {
+  if (this != &other) other.cloneInto(*this);
+  return *this;
 }
 
+void Engine::cloneInto(Engine& dst) const {
+  // cfg_.best_path и файл рекорда не копируются: строка выделяет память,
+  // а копии все равно не пишут рекорд. Собственный файл рекорда цели
+  // остается до ее деструктора: его закрытие ждет фоновую запись, а
+  // копирование в арену не должно касаться диска
+  dst.cfg_.width = cfg_.width;
+  dst.cfg_.height = cfg_.height;
+  dst.cfg_.seed = cfg_.seed;
+  dst.cfg_.wrap = cfg_.wrap;
+  dst.cfg_.persist = false;
+  dst.cfg_.best_store = nullptr;
+  dst.persist_ = false;
+  dst.best_store_ = nullptr;
+  dst.state_ = state_;
+  dst.dir_ = dir_;
+  dst.input_ = input_;
+  dst.snake_ = snake_;
+  dst.grid_ = grid_;
+  dst.occupied_ = occupied_;
+  dst.free_cells_ = free_cells_;
+  dst.free_pos_ = free_pos_;
+  dst.free_count_ = free_count_;
+  dst.score_ = score_;
+  dst.food_ = food_;
+  dst.rng_state_ = rng_state_;
+  dst.best_ = best_;
+  dst.level_ = level_;
+  dst.speed_ms_ = speed_ms_;
+  dst.wrap_mask_x_ = wrap_mask_x_;
+  dst.wrap_mask_y_ = wrap_mask_y_;
+  dst.changes_ = changes_;
+}
+
+namespace {
+constexpr std::uint8_t kStateMagic[] = {'S', '2', '1', 'S'};
+constexpr std::uint8_t kStateVersion = 2;
+}  // namespace
+
+void Engine::saveState(std::vector<std::uint8_t>& out) const {
+  out.assign(std::begin(kStateMagic), std::end(kStateMagic));
+  out.push_back(kStateVersion);
+  varint::put(out, W());
+  varint::put(out, H());
+  varint::put(out, cfg_.wrap);
+  varint::put(out, static_cast<std::uint64_t>(state_));
+  varint::put(out, static_cast<std::uint64_t>(dir_));
+  InputQueue q = input_;
+  varint::put(out, q.size());
+  while (!q.empty())
+    varint::put(out, static_cast<std::uint64_t>(q.next(dir_)));
+  varint::put(out, score_);
+  varint::put(out, best_);
+  varint::put(out, rng_state_.state);
+  varint::put(out, rng_state_.inc);
+  // Еда хранится со сдвигом на 1: {-1, -1} превращается в 0
+  varint::put(out, food_.first < 0 ? 0 : idx(food_.first, food_.second) + 1);
+  varint::put(out, snake_.size());
+  for (const Point& p : snake_) varint::put(out, idx(p.x, p.y));
+  varint::put(out, free_count_);
+  for (int i = 0; i < free_count_; ++i) varint::put(out, free_cells_[i]);
+}
+
+bool Engine::loadState(std::span<const std::uint8_t> data) {
+  varint::Reader in(data);
+  const std::uint64_t cells = static_cast<std::uint64_t>(W()) * H();
+  std::uint64_t v, w, h;
+
+  for (std::uint8_t m : kStateMagic) {
+    std::uint8_t b;
+    if (!in.byte(b) || b != m) return false;
+  }
+  std::uint8_t version;
+  if (!in.byte(version) || version != kStateVersion || !in.value(w) ||
+      !in.value(h) || w != static_cast<std::uint64_t>(W()) ||
+      h != static_cast<std::uint64_t>(H()))
+    return false;
+
+  // Поля партии читаются в локальные переменные и переносятся в движок
+  // только после проверки всего блока. Тело и индекс свободных клеток
+  // собираются сразу на месте: при ошибке они строятся заново
+  auto fail = [this] {
+    placeInitialSnake();
+    score_ = 0;
+    rng_state_ = rules::seedState(cfg_.seed);
+    food_ = {-1, -1};
+    spawnFood();
+    recomputeLevelAndSpeed();
+    applySnakeToGrid();
+    changes_ = ChangeList{};
+    changes_.full_redraw = true;
+    return false;
+  };
+
+  if (!in.value(v, 1)) return fail();
+  const bool wrap = v != 0;
+  if (!in.value(v, static_cast<std::uint64_t>(State::kGameOver))) return fail();
+  const auto state = static_cast<State>(v);
+  if (!in.value(v, static_cast<std::uint64_t>(Direction::kRight)))
+    return fail();
+  const auto dir = static_cast<Direction>(v);
+
+  InputQueue input;
+  std::uint64_t queued;
+  if (!in.value(queued, InputQueue::kCapacity)) return fail();
+  for (std::uint64_t k = 0; k < queued; ++k) {
+    if (!in.value(v, static_cast<std::uint64_t>(Direction::kRight)) ||
+        !input.push(dir, static_cast<Direction>(v)))
+      return fail();
+  }
+
+  std::uint64_t score, best;
+  if (!in.value(score, cells) ||
+      !in.value(best, std::numeric_limits<int>::max()))
+    return fail();
+  // Приращение потока PCG всегда нечетное
+  std::uint64_t rng_state, inc;
+  if (!in.value(rng_state) || !in.value(inc) || (inc & 1u) == 0)
+    return fail();
+  std::uint64_t food;
+  if (!in.value(food, cells)) return fail();
+
+  // Тело: клетки в поле и без повторов
+  std::uint64_t len;
+  if (!in.value(len, cells) || len == 0) return fail();
+  snake_.clear();
+  std::fill(occupied_.begin(), occupied_.end(), 0);
+  std::fill(free_pos_.begin(), free_pos_.end(), -1);
+  for (std::uint64_t k = 0; k < len; ++k) {
+    if (!in.value(v, cells - 1) || isOccupied(static_cast<int>(v)))
+      return fail();
+    const int i = static_cast<int>(v);
+    occupied_[i >> 6] |= std::uint64_t{1} << (i & 63);
+    snake_.push_back(pointAt(i));
+  }
+
+  // Индекс свободных клеток: ровно все незанятые клетки, каждая один раз
+  std::uint64_t free_count;
+  if (!in.value(free_count, cells) || free_count != cells - len) return fail();
+  free_count_ = static_cast<int>(free_count);
+  for (int k = 0; k < free_count_; ++k) {
+    if (!in.value(v, cells - 1)) return fail();
+    const int i = static_cast<int>(v);
+    if (isOccupied(i) || free_pos_[i] != -1) return fail();
+    free_cells_[k] = i;
+    free_pos_[i] = k;
+  }
+  if (!in.atEnd()) return fail();
+  // Еда хранится со сдвигом на 1
+  if (food != 0 && isOccupied(static_cast<int>(food - 1))) return fail();
+
+  cfg_.wrap = wrap;
+  state_ = state;
+  dir_ = dir;
+  input_ = input;
+  score_ = static_cast<int>(score);
+  best_ = static_cast<int>(best);
+  rng_state_ = {rng_state, inc};
+  food_ = food == 0 ? std::pair<int, int>{-1, -1}
+                    : std::pair<int, int>{static_cast<int>(food - 1) % W(),
+                                          static_cast<int>(food - 1) / W()};
+  recomputeLevelAndSpeed();
+  applySnakeToGrid();
+  changes_ = ChangeList{};
+  changes_.full_redraw = true;
+  return true;
+}
+
+State Engine::state() const { return state_; }
+
 void Engine::resetGrid() {
   std::fill(grid_.begin(), grid_.end(), Cell::kEmpty);
 }
 
 void Engine::placeInitialSnake() {
-  int cx = W() / 2, cy = H() / 2;
   snake_.clear();
-  snake_.push_front({cx, cy});
-  snake_.push_back({cx - 1, cy});
-  snake_.push_back({cx - 2, cy});
+  rules::layInitialSnake(
+      W(), H(), [this](int x, int y) { snake_.push_back(pointAt(idx(x, y))); });
+  std::fill(occupied_.begin(), occupied_.end(), 0);
+  free_count_ = W() * H();
+  for (int i = 0; i < free_count_; ++i) free_cells_[i] = free_pos_[i] = i;
+  for (auto& p : snake_) occupyCell(idx(p.x, p.y));
   dir_ = Direction::kRight;
+  input_.clear();
   state_ = State::kInit;
 }
 
@@ -58,101 +324,100 @@ void Engine::applySnakeToGrid() {
     grid_[idx(food_.first, food_.second)] = Cell::kFood;
 }
 
+template <bool kTrackGrid>
 void Engine::step() {
-  Point head = snake_.front();
-  Point next = head;
-  if (dir_ == Direction::kRight) next.x += 1;
-  if (dir_ == Direction::kLeft) next.x -= 1;
-  if (dir_ == Direction::kDown) next.y += 1;
-  if (dir_ == Direction::kUp) next.y -= 1;
-
-  if (next.x < 0 || next.x >= W() || next.y < 0 || next.y >= H()) {
+  int nx = snake_.front().x, ny = snake_.front().y;
+  if (!rules::stepHead(nx, ny, dir_, W(), H(), cfg_.wrap, wrap_mask_x_,
+                       wrap_mask_y_)) {
     state_ = State::kGameOver;
     UpdateBest();
     return;
   }
-
-  for (auto& p : snake_) {
-    if (p.x == next.x && p.y == next.y) {
-      state_ = State::kGameOver;
-      UpdateBest();
-      return;
+  // Поле обновляется точечно: меняются только хвост, голова и еда.
+  // В run() поле не ведется вовсе и перестраивается в finishRun().
+  struct Body {
+    Engine& e;
+    Point next;  ///< Та же клетка, что индекс в pushHead(), без деления
+    int tail() const {
+      const Point t = e.snake_.back();
+      return e.idx(t.x, t.y);
+    }
+    void popTail(int i) {
+      if constexpr (kTrackGrid) {
+        e.grid_[i] = Cell::kEmpty;
+        e.recordCell(i, Cell::kEmpty);
+      }
+      e.releaseCell(i);
+      e.snake_.pop_back();
+    }
+    void pushHead(int i) {
+      e.snake_.push_front(next);
+      e.occupyCell(i);
+      if constexpr (kTrackGrid) {
+        e.grid_[i] = Cell::kSnake;
+        e.recordCell(i, Cell::kSnake);
+      }
+    }
+    void eat() {
+      e.score_ += 1;
+      e.recomputeLevelAndSpeed();
+      e.spawnFood();
+      if (kTrackGrid && e.food_.first >= 0) {
+        const int food_i = e.idx(e.food_.first, e.food_.second);
+        e.grid_[food_i] = Cell::kFood;
+        e.recordCell(food_i, Cell::kFood);
+      }
     }
+  };
+  const Point next{static_cast<Coord>(nx), static_cast<Coord>(ny)};
+  const int next_i = idx(nx, ny);
+  const bool grows = food_.first == nx && food_.second == ny;
+  if (!rules::advance(Body{*this, next}, next_i, grows, isOccupied(next_i))) {
+    state_ = State::kGameOver;
+    UpdateBest();
   }
+}
 
-  snake_.push_front(next);
+template void Engine::step<true>();
+template void Engine::step<false>();
 
-  if (food_.first == next.x && food_.second == next.y) {
-    score_ += 1;
-    recomputeLevelAndSpeed();
-    spawnFood();
-  } else {
-    snake_.pop_back();
-  }
+void Engine::finishRun(State prev_state, int prev_score, int prev_best,
+                       int prev_level) {
+  applySnakeToGrid();
+  changes_ = ChangeList{};
+  changes_.full_redraw = true;
+  changes_.state_changed = state_ != prev_state;
+  changes_.score_changed = score_ != prev_score;
+  changes_.best_changed = best_ != prev_best;
+  changes_.level_changed = level_ != prev_level;
+}
+
+void Engine::recordCell(int i, Cell::Type t) {
+  changes_.cells[changes_.count++] = {pointAt(i), t};
 }
 
 void Engine::dispatch(Event e) {
-  switch (e) {
-    case Event::kStart:
-      if (state_ == State::kInit || state_ == State::kReady ||
-          state_ == State::kGameOver) {
+  const State prev_state = state_;
+  const int prev_score = score_, prev_best = best_, prev_level = level_;
+  changes_ = ChangeList{};
+
+  rules::dispatch(
+      e, state_, dir_, input_,
+      [this](State next) {
         placeInitialSnake();
+        ensureFood();
         score_ = 0;
+        if (next == State::kRunning) syncBest();
         recomputeLevelAndSpeed();
         applySnakeToGrid();
-        state_ = State::kRunning;
-      }
-      break;
-    case Event::kReset:
-      placeInitialSnake();
-      score_ = 0;
-      level_ = 1;
-      recomputeLevelAndSpeed();
-      applySnakeToGrid();
-      state_ = State::kReady;  // Готовность к запуску
-      break;
-    case Event::kPauseToggle:
-      if (state_ == State::kRunning)
-        state_ = State::kPaused;
-      else if (state_ == State::kPaused)
-        state_ = State::kRunning;
-      break;
-    case Event::kMoveUp:
-    case Event::kMoveDown:
-    case Event::kMoveLeft:
-    case Event::kMoveRight: {
-      if (state_ != State::kRunning) break;
-      Direction want = dir_;
-      switch (e) {
-        case Event::kMoveUp:
-          want = Direction::kUp;
-          break;
-        case Event::kMoveDown:
-          want = Direction::kDown;
-          break;
-        case Event::kMoveLeft:
-          want = Direction::kLeft;
-          break;
-        case Event::kMoveRight:
-          want = Direction::kRight;
-          break;
-        default:
-          break;
-      }
-      if (!isOpposite(dir_, want)) {
-        dir_ = want;
-      }
-      break;
-    }
-    case Event::kTick:
-      if (state_ == State::kRunning) {
-        step();
-        applySnakeToGrid();
-      }
-      break;
-    case Event::kQuit:
-      break;
-  }
+        changes_.full_redraw = true;
+      },
+      [this] { step<true>(); });
+
+  changes_.state_changed = state_ != prev_state;
+  changes_.score_changed = score_ != prev_score;
+  changes_.best_changed = best_ != prev_best;
+  changes_.level_changed = level_ != prev_level;
 }
 
 Snapshot Engine::snapshot() const {
@@ -171,41 +436,65 @@ Snapshot Engine::snapshot() const {
   return s;
 }
 
+void Engine::snapshot(Snapshot& s) const {
+  s.state = state_;
+  s.width = W();
+  s.height = H();
+  s.grid.assign(grid_.begin(), grid_.end());
+  s.score = score_;
+  s.best = best_;
+  s.level = level_;
+  s.speed_ms = speed_ms_;
+  // Сразу под все поле, чтобы рост змейки не перевыделял память
+  s.snake.reserve(snake_.capacity());
+  s.snake.clear();
+  for (auto& p : snake_) s.snake.emplace_back(p.x, p.y);
+  s.food = food_;
+}
+
+SnapshotView Engine::view() const {
+  SnapshotView v;
+  v.state = state_;
+  v.width = W();
+  v.height = H();
+  v.grid = grid_;
+  v.score = score_;
+  v.best = best_;
+  v.level = level_;
+  v.speed_ms = speed_ms_;
+  v.snake = {snake_.headSegment(), snake_.tailSegment()};
+  v.food = food_;
+  return v;
+}
+
 bool Engine::isSnakeCell(int x, int y) const {
-  for (auto& p : snake_)
-    if (p.x == x && p.y == y) return true;
-  return false;
+  if (x < 0 || x >= W() || y < 0 || y >= H()) return false;
+  return isOccupied(idx(x, y));
 }
 
-unsigned Engine::nextRand() {
-  unsigned x = rng_state_;
-  x ^= x << 13;
-  x ^= x >> 17;
-  x ^= x << 5;
-  rng_state_ = x;
-  return x;
+void Engine::occupyCell(int i) {
+  occupied_[i >> 6] |= std::uint64_t{1} << (i & 63);
+  rules::takeFree(free_cells_.data(), free_pos_.data(), free_count_, i);
 }
 
-void Engine::spawnFood() {
-  for (int tries = 0; tries < 1000; ++tries) {
-    int x = (int)(nextRand() % W());
-    int y = (int)(nextRand() % H());
-    if (!isSnakeCell(x, y)) {
-      food_ = {x, y};
-      return;
-    }
-  }
+void Engine::releaseCell(int i) {
+  occupied_[i >> 6] &= ~(std::uint64_t{1} << (i & 63));
+  rules::putFree(free_cells_.data(), free_pos_.data(), free_count_, i);
+}
 
-  for (int y = 0; y < H(); ++y) {
-    for (int x = 0; x < W(); ++x) {
-      if (!isSnakeCell(x, y)) {
-        food_ = {x, y};
-        return;
-      }
-    }
-  }
+unsigned Engine::nextRand() { return rules::nextRand(rng_state_); }
+
+void Engine::spawnFood() {
+  int i = rules::pickFoodCell(rng_state_, free_cells_.data(), free_count_);
+  if (i < 0)
+    food_ = {-1, -1};
+  else
+    food_ = {i % W(), i / W()};
+}
 
-  food_ = {-1, -1};
+void Engine::ensureFood() {
+  // Еда прошлой партии могла оказаться под новой змейкой
+  if (food_.first < 0 || isSnakeCell(food_.first, food_.second)) spawnFood();
 }
 
 std::string Engine::defaultBestPath() const {
@@ -214,46 +503,25 @@ std::string Engine::defaultBestPath() const {
   return base + "/.s21_snake_best";
 }
 
-int Engine::loadBestFromFile(const std::string& path) {
-  std::ifstream in(path);
-  int v = 0;
-  if (in) in >> v;
-  return v < 0 ? 0 : v;
-}
-
-void Engine::saveBestToFile(const std::string& path, int v) {
-  try {
-    std::filesystem::path p(path);
-    if (p.has_parent_path())
-      std::filesystem::create_directories(p.parent_path());
-  } catch (...) {
-  }
-
-  std::ofstream out(path, std::ios::trunc);
-
-  if (!out) return;
-  out << v << "\n";
-  out.flush();
+void Engine::syncBest() {
+  BestStore* s = persist_ ? store() : nullptr;
+  if (s) best_ = std::max(best_, s->load());
 }
 
 void Engine::UpdateBest() {
   if (score_ > best_) {
     best_ = score_;
-    saveBestToFile(best_path_, best_);
+    if (!persist_) return;
+    if (BestStore* s = store()) s->save(best_);
   }
 }
 
 int Engine::levelForScore(int score) const {
-  int lvl = 1 + score / 5;
-  if (lvl > 10) lvl = 10;
-  return lvl;
+  return rules::levelForScore(score);
 }
 
 int Engine::speedForLevel(int level) const {
-  int base = 200;
-  int step = 15;
-  int ms = base - (level - 1) * step;
-  return ms < 60 ? 60 : ms;
+  return rules::speedForLevel(level);
 }
 
 void Engine::recomputeLevelAndSpeed() {
@@ -11,11 +11,24 @@
  */
 
 #pragma once
-#include <deque>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "../common/pcg32.h"
+#include "ring_buffer.h"
+
+struct ps_slot;  // brick_game/common/persist.h
+
 /**
  * @namespace s21::snake
  * @brief Пространство имен игры Snake
@@ -25,6 +38,15 @@
  * Реализует паттерн MVC и конечный автомат для управления состояниями игры.
  */
 namespace s21::snake {
+/**
+ * @brief Тип координаты клетки
+ *
+ * @details
+ * 16 бит хватает для полей до 32767x32767 и вдвое уменьшает тело змейки
+ * в памяти и в снимках.
+ */
+using Coord = std::int16_t;
+
 /**
  * @enum Event
  * @brief События игры Snake
@@ -62,6 +84,95 @@ enum class State {
   kGameOver   ///< Игра завершена
 };
 
+/**
+ * @class BestStore
+ * @brief Приемник лучшего результата вместо файла
+ *
+ * @details
+ * Позволяет хосту самому решать, когда и куда сохранять рекорд
+ * (например, копить его в памяти и писать на диск пачкой). Движок не
+ * владеет приемником. Если один приемник разделяют движки из разных
+ * потоков, он должен быть потокобезопасным.
+ */
+class BestStore {
+ public:
+  virtual ~BestStore() = default;
+
+  /** @brief Рекорд на момент вызова; может ждать первого чтения */
+  virtual int load() = 0;
+
+  /** @brief load() не будет ждать (рекорд уже прочитан) */
+  virtual bool ready() { return true; }
+
+  /** @brief Движок установил новый рекорд */
+  virtual void save(int best) = 0;
+};
+
+/**
+ * @class MemoryBestStore
+ * @brief Потокобезопасный рекорд в памяти для пакетных прогонов
+ */
+class MemoryBestStore : public BestStore {
+ public:
+  explicit MemoryBestStore(int initial = 0) : best_(initial) {}
+
+  int load() override { return best_.load(std::memory_order_relaxed); }
+
+  void save(int best) override {
+    int cur = best_.load(std::memory_order_relaxed);
+    while (best > cur && !best_.compare_exchange_weak(
+                             cur, best, std::memory_order_relaxed)) {
+    }
+  }
+
+  int best() const { return best_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int> best_;
+};
+
+/**
+ * @class FileBestStore
+ * @brief Рекорд в файле через фоновый сервис brick_game/common/persist.h
+ *
+ * @details
+ * Конструктор только ставит чтение файла в очередь, поэтому создание
+ * движка не ждет диска; load() ждет это чтение, только если оно еще не
+ * закончилось. save() не блокирует: новые рекорды схлопываются, а файл
+ * подменяется атомарно. Запись идет через слот persist.h, выделенный в
+ * конструкторе, так что save() на тике Game Over не выделяет память.
+ * Рекорд, установленный до окончания чтения, сравнивается с прочитанным
+ * и пишется после него. Деструктор дожидается записи на диск.
+ */
+class FileBestStore : public BestStore {
+ public:
+  /** @param path Путь к файлу с лучшим результатом */
+  explicit FileBestStore(std::string path);
+  ~FileBestStore() override;
+
+  FileBestStore(const FileBestStore&) = delete;
+  FileBestStore& operator=(const FileBestStore&) = delete;
+
+  int load() override;
+  bool ready() override;
+  void save(int best) override;
+
+  const std::string& path() const { return path_; }
+
+ private:
+  static void onLoaded(void* ctx, const char* data, std::size_t len,
+                       int found);
+  void writeLocked();
+
+  std::string path_;
+  ps_slot* slot_{nullptr};  ///< Буфер записи; без него — ps_write_async()
+  std::mutex mu_;
+  std::condition_variable loaded_cv_;
+  bool loaded_{false};  ///< Первое чтение завершилось
+  bool dirty_{false};   ///< Рекорд изменился до окончания чтения
+  int best_{0};
+};
+
 /**
  * @struct Config
  * @brief Конфигурация игры Snake
@@ -74,6 +185,10 @@ struct Config {
   unsigned seed{0};             ///< Семя для генератора случайных чисел
   bool wrap{false};             ///< Обертывание змейки через границы
   std::string best_path{};      ///< Путь к файлу с лучшим результатом
+  /// false — чистая симуляция: рекорд не читается и не сохраняется
+  bool persist{true};
+  /// Приемник рекорда вместо файла best_path (не владеет)
+  BestStore* best_store{nullptr};
 };
 
 /**
@@ -88,7 +203,7 @@ struct Cell {
    * @enum Type
    * @brief Типы клеток
    */
-  enum Type { 
+  enum Type : std::uint8_t {
     kEmpty,  ///< Пустая клетка
     kSnake,  ///< Клетка змейки
     kFood    ///< Клетка с едой
@@ -106,9 +221,9 @@ struct Cell {
 struct Snapshot {
   State state;                                    ///< Текущее состояние игры
   int width, height;                              ///< Размеры поля
-  std::vector<Cell::Type> grid;                  ///< Игровое поле
+  std::vector<Cell::Type> grid;                  ///< Игровое поле (1 байт/клетка)
   int score, best, level, speed_ms;               ///< Игровые параметры
-  std::vector<std::pair<int, int>> snake;         ///< Координаты змейки
+  std::vector<std::pair<Coord, Coord>> snake;     ///< Координаты змейки
   std::pair<int, int> food;                       ///< Координаты еды
 };
 
@@ -120,7 +235,7 @@ struct Snapshot {
  * Простая структура для представления координат.
  */
 struct Point {
-  int x{0}, y{0};  ///< Координаты точки
+  Coord x{0}, y{0};  ///< Координаты точки
 };
 
 /**
@@ -136,6 +251,203 @@ enum class Direction {
   kLeft,   ///< Влево
   kRight   ///< Вправо
 };
+
+/** @brief Противоположны ли направления */
+inline bool isOpposite(Direction a, Direction b) {
+  return (a == Direction::kLeft && b == Direction::kRight) ||
+         (a == Direction::kRight && b == Direction::kLeft) ||
+         (a == Direction::kUp && b == Direction::kDown) ||
+         (a == Direction::kDown && b == Direction::kUp);
+}
+
+/**
+ * @class InputQueue
+ * @brief Очередь поворотов между тиками
+ *
+ * @details
+ * Нажатия копятся в очереди фиксированной емкости, и каждый kTick
+ * забирает из нее не больше одного поворота. Новое нажатие сверяется с
+ * последним поворотом в очереди, а не с текущим направлением, поэтому
+ * быстрые "вверх, влево" при движении вправо дают два поворота подряд,
+ * а не разворот в собственную шею. Память не выделяется.
+ */
+class InputQueue {
+ public:
+  /// Сколько поворотов помнится наперед; лишние нажатия отбрасываются
+  static constexpr std::size_t kCapacity = 4;
+
+  /**
+   * @brief Поставить поворот в очередь
+   * @param current Текущее направление движения
+   * @param want Нажатое направление
+   * @return false, если поворот повторяет или разворачивает последний
+   *         поворот в очереди (или current), либо очередь полна
+   */
+  bool push(Direction current, Direction want) {
+    const Direction last = size_ ? items_[wrap(head_ + size_ - 1)] : current;
+    if (want == last || isOpposite(last, want) || size_ == kCapacity)
+      return false;
+    items_[wrap(head_ + size_)] = want;
+    ++size_;
+    return true;
+  }
+
+  /**
+   * @brief Направление на очередной тик
+   * @param current Текущее направление; возвращается, если очередь пуста
+   */
+  Direction next(Direction current) {
+    if (size_ == 0) return current;
+    const Direction d = items_[head_];
+    head_ = wrap(head_ + 1);
+    --size_;
+    return d;
+  }
+
+  void clear() { head_ = size_ = 0; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  static std::size_t wrap(std::size_t i) {
+    return i >= kCapacity ? i - kCapacity : i;
+  }
+
+  std::array<Direction, kCapacity> items_{};
+  std::size_t head_{0};
+  std::size_t size_{0};
+};
+/**
+ * @struct BodyView
+ * @brief Невладеющее представление тела змейки
+ *
+ * @details
+ * Тело хранится в кольцевом буфере, поэтому представлено двумя участками:
+ * от головы до конца хранилища и продолжением с его начала.
+ * Индекс 0 — голова.
+ */
+struct BodyView {
+  std::span<const Point> head_part;  ///< Участок, начинающийся с головы
+  std::span<const Point> tail_part;  ///< Участок, заканчивающийся хвостом
+
+  /**
+   * @class const_iterator
+   * @brief Итератор от головы к хвосту
+   */
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Point;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Point*;
+    using reference = const Point&;
+
+    const_iterator() = default;
+    const_iterator(const BodyView* v, std::size_t i) : v_(v), i_(i) {}
+
+    reference operator*() const { return (*v_)[i_]; }
+    pointer operator->() const { return &(*v_)[i_]; }
+    const_iterator& operator++() {
+      ++i_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator t = *this;
+      ++i_;
+      return t;
+    }
+    bool operator==(const const_iterator& o) const { return i_ == o.i_; }
+    bool operator!=(const const_iterator& o) const { return i_ != o.i_; }
+
+   private:
+    const BodyView* v_{nullptr};
+    std::size_t i_{0};
+  };
+
+  std::size_t size() const { return head_part.size() + tail_part.size(); }
+  bool empty() const { return size() == 0; }
+  const Point& operator[](std::size_t i) const {
+    return i < head_part.size() ? head_part[i]
+                                : tail_part[i - head_part.size()];
+  }
+  const Point& front() const { return (*this)[0]; }
+  const Point& back() const { return (*this)[size() - 1]; }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size()); }
+};
+
+/**
+ * @struct SnapshotView
+ * @brief Заимствованный снимок состояния игры без копирования
+ *
+ * @details
+ * Поля совпадают со Snapshot, но поле и тело змейки — ссылки на память
+ * движка. Представление действительно до следующего вызова
+ * Engine::dispatch() и пока жив сам движок.
+ */
+struct SnapshotView {
+  State state{State::kInit};                   ///< Текущее состояние игры
+  int width{0}, height{0};                     ///< Размеры поля
+  std::span<const Cell::Type> grid;            ///< Игровое поле
+  int score{0}, best{0}, level{1}, speed_ms{0};  ///< Игровые параметры
+  BodyView snake;                              ///< Тело змейки
+  std::pair<int, int> food{-1, -1};            ///< Координаты еды
+};
+
+/**
+ * @struct CellChange
+ * @brief Изменение одной клетки поля
+ */
+struct CellChange {
+  Point pos;        ///< Координаты клетки
+  Cell::Type type;  ///< Новое содержимое клетки
+};
+
+/**
+ * @struct ChangeList
+ * @brief Изменения, внесенные последним вызовом Engine::dispatch()
+ *
+ * @details
+ * Тик меняет не более трех клеток: освобожденный хвост, новую голову и
+ * новую еду. При full_redraw (kStart/kReset) поле перестроено целиком и
+ * список клеток не заполняется — нужно перечитать все поле.
+ */
+struct ChangeList {
+  static constexpr int kCapacity = 3;        ///< Максимум клеток за тик
+  std::array<CellChange, kCapacity> cells{};  ///< Измененные клетки
+  int count{0};                                ///< Число изменений в cells
+  bool full_redraw{false};                     ///< Поле перестроено целиком
+  bool state_changed{false};                   ///< Изменилось состояние
+  bool score_changed{false};                   ///< Изменился счет
+  bool best_changed{false};                    ///< Изменился рекорд
+  bool level_changed{false};                   ///< Изменились уровень/скорость
+
+  /** @brief Измененные клетки в порядке применения */
+  std::span<const CellChange> cellChanges() const {
+    return {cells.data(), static_cast<std::size_t>(count)};
+  }
+};
+
+/**
+ * @enum StopReason
+ * @brief Почему Engine::run() вернул управление
+ */
+enum class StopReason {
+  kDeath,      ///< Змейка врезалась в стену или в себя
+  kTickCap,    ///< Исчерпан лимит тиков
+  kBoardFull,  ///< Змейка заняла все поле
+  kNotRunning  ///< Игра не была в состоянии kRunning
+};
+
+/**
+ * @struct RunResult
+ * @brief Итог Engine::run()
+ */
+struct RunResult {
+  StopReason reason{StopReason::kNotRunning};  ///< Причина остановки
+  int ticks{0};                                ///< Сделано тиков
+};
+
 /**
  * @class Engine
  * @brief Игровой движок Snake
@@ -152,6 +464,57 @@ class Engine {
    * @param cfg Конфигурация игры
    */
   explicit Engine(Config cfg = {});
+
+  /**
+   * @brief Копия для поиска и симуляции
+   *
+   * @details
+   * Копия не знает пути к файлу рекорда и никогда не обращается к
+   * файловой системе, в том числе в деструкторе.
+   */
+  Engine(const Engine& other);
+
+  /** @brief Присваивание через cloneInto(): цель перестает сохранять рекорд */
+  Engine& operator=(const Engine& other);
+
+  Engine(Engine&&) = default;
+  Engine& operator=(Engine&&) = default;
+
+  /**
+   * @brief Скопировать состояние в существующий движок
+   *
+   * @details
+   * Цель служит заранее выделенной ареной: при совпадающем размере поля
+   * память не выделяется, а файловая система не затрагивается. Цель
+   * перестает сохранять рекорд в файл.
+   *
+   * @param dst Движок-приемник
+   */
+  void cloneInto(Engine& dst) const;
+
+  /**
+   * @brief Записать состояние партии в компактный двоичный блок
+   *
+   * @details
+   * Формат: "S21S", версия, затем varint: ширина, высота, wrap, состояние,
+   * направление, очередь нажатий, счет, рекорд, ГПСЧ (state и inc
+   * PCG32), еда, тело от головы и порядок индекса свободных клеток (от
+   * него зависит выбор еды). Поле, уровень и скорость восстанавливаются
+   * по ним.
+   *
+   * @param out Приемник; очищается, емкость переиспользуется
+   */
+  void saveState(std::vector<std::uint8_t>& out) const;
+
+  /**
+   * @brief Восстановить состояние из блока saveState()
+   * @param data Блок
+   * @return false, если блок поврежден или размер поля другой. Чужой
+   *         заголовок движок не меняет, а при поврежденном содержимом
+   *         он сбрасывается в начальное состояние (kInit), как новый
+   *         Engine с той же конфигурацией, но с прежним рекордом
+   */
+  bool loadState(std::span<const std::uint8_t> data);
   
   /**
    * @brief Получить текущее состояние игры
@@ -170,7 +533,118 @@ class Engine {
    * @return Снимок текущего состояния
    */
   Snapshot snapshot() const;
-  
+
+  /**
+   * @brief Заполнить снимок, переиспользуя его память
+   * @param out Снимок; после первого вызова для поля того же размера
+   *            больше не выделяет память
+   */
+  void snapshot(Snapshot& out) const;
+
+  /**
+   * @brief Получить снимок состояния без копирования
+   * @return Представление, действительное до следующего dispatch()
+   */
+  SnapshotView view() const;
+
+  /**
+   * @brief Записать наблюдение партии (observation.h) в буфер
+   * @param out observationSize(W, H) элементов, порядок CHW
+   * @return false, если буфер мал; память не выделяется
+   */
+  bool observe(std::span<std::uint8_t> out) const;
+
+  /** @brief То же в float */
+  bool observe(std::span<float> out) const;
+
+  /**
+   * @brief Изменения, внесенные последним dispatch()
+   * @return Список фиксированной емкости; не выделяет память
+   */
+  const ChangeList& changes() const { return changes_; }
+
+  /**
+   * @brief Голова змейки
+   * @return Координаты головы без копирования всего снимка
+   */
+  Point head() const { return snake_.front(); }
+
+  /**
+   * @brief Хвост змейки
+   * @return Клетка, которую змейка освободит на следующем тике без роста
+   */
+  Point tail() const { return snake_.back(); }
+
+  /**
+   * @brief Текущее направление движения
+   * @return Направление, в котором пойдет следующий тик
+   */
+  Direction direction() const { return dir_; }
+
+  /**
+   * @brief Число поворотов, ожидающих своих тиков
+   * @return От 0 до InputQueue::kCapacity
+   */
+  std::size_t queuedMoves() const { return input_.size(); }
+
+  /**
+   * @brief Координаты еды
+   * @return {-1, -1}, если еды нет (поле заполнено)
+   */
+  std::pair<int, int> food() const { return food_; }
+
+  /**
+   * @brief Занята ли клетка змейкой
+   * @return false и для клеток за пределами поля
+   */
+  bool isSnakeCell(int x, int y) const;
+
+  /** @brief Ширина поля */
+  int width() const { return cfg_.width; }
+
+  /** @brief Высота поля */
+  int height() const { return cfg_.height; }
+
+  /** @brief Поле-тор: змейка проходит сквозь границы */
+  bool wrap() const { return cfg_.wrap; }
+
+  /**
+   * @brief Битовая карта клеток змейки
+   * @return Бит i (слово i / 64, бит i % 64) — клетка y * width + x;
+   *         действительна до следующего шага
+   */
+  std::span<const std::uint64_t> occupancy() const { return occupied_; }
+
+  /**
+   * @brief Прокрутить игру без интерфейса
+   *
+   * @details
+   * На каждом тике вызывает policy(const Engine&) -> Direction, поворачивает
+   * (разворот на 180° игнорируется) и делает шаг. Вызов policy встраивается
+   * в цикл. Поле grid и список изменений не ведутся до выхода из run(),
+   * поэтому стратегия должна опираться на head(), direction(), food() и
+   * isSnakeCell(), а не на view(). После выхода changes() сообщает
+   * full_redraw. Очередь нажатий сбрасывается: повороты задает policy.
+   *
+   * @param max_ticks Предел тиков
+   * @param policy Стратегия
+   * @return Причина остановки и число сделанных тиков
+   */
+  template <class Policy>
+  RunResult run(int max_ticks, Policy&& policy);
+
+  /**
+   * @brief Текущая длина змейки
+   * @return Количество сегментов тела
+   */
+  std::size_t length() const { return snake_.size(); }
+
+  /**
+   * @brief Количество свободных от змейки клеток
+   * @return Число клеток, куда может быть помещена еда; 0 — поле заполнено
+   */
+  std::size_t freeCells() const { return free_count_; }
+
   /**
    * @brief Деструктор
    */
@@ -180,15 +654,25 @@ class Engine {
   Config cfg_;                           ///< Конфигурация игры
   State state_{State::kInit};            ///< Текущее состояние
   Direction dir_{Direction::kRight};     ///< Направление движения
-  std::deque<Point> snake_;              ///< Координаты змейки
+  InputQueue input_;                     ///< Повороты до следующих тиков
+  RingBuffer<Point> snake_;              ///< Координаты змейки (0 — голова)
   std::vector<Cell::Type> grid_;         ///< Игровое поле
+  std::vector<std::uint64_t> occupied_;  ///< Битовая карта клеток змейки
+  std::vector<int> free_cells_;          ///< Плотный список свободных клеток
+  std::vector<int> free_pos_;            ///< Позиция клетки в free_cells_
+  int free_count_{0};                    ///< Число свободных клеток
   int score_{0};                         ///< Текущий счет
   std::pair<int, int> food_{-1, -1};   ///< Координаты еды
-  unsigned rng_state_{0};                 ///< Состояние ГПСЧ
+  pcg32_t rng_state_{};                  ///< Состояние ГПСЧ
   int best_{0};                          ///< Лучший результат
-  std::string best_path_;                ///< Путь к файлу с лучшим результатом
+  bool persist_{true};                   ///< Сохранять рекорд
+  BestStore* best_store_{nullptr};       ///< Внешний приемник рекорда
+  std::unique_ptr<BestStore> own_store_;  ///< Файл рекорда без приемника
   int level_{1};                         ///< Текущий уровень
   int speed_ms_{200};
+  int wrap_mask_x_{0};                   ///< rules::wrapMask(width)
+  int wrap_mask_y_{0};                   ///< rules::wrapMask(height)
+  ChangeList changes_;                   ///< Изменения последнего dispatch()
   int levelForScore(int score) const;
   int speedForLevel(int level) const;
   void recomputeLevelAndSpeed();
@@ -196,18 +680,58 @@ class Engine {
   int W() const { return cfg_.width; }
   int H() const { return cfg_.height; }
   int idx(int x, int y) const { return y * W() + x; }
-  bool isOpposite(Direction a, Direction b) const;
+  Point pointAt(int i) const {
+    return {static_cast<Coord>(i % W()), static_cast<Coord>(i / W())};
+  }
+  bool isOccupied(int i) const {
+    return (occupied_[i >> 6] >> (i & 63)) & 1u;
+  }
+  void occupyCell(int i);
+  void releaseCell(int i);
   void resetGrid();
   void placeInitialSnake();
   void applySnakeToGrid();
+  template <bool kTrackGrid>
   void step();
+  void finishRun(State prev_state, int prev_score, int prev_best,
+                 int prev_level);
   void spawnFood();
-  bool isSnakeCell(int x, int y) const;
+  void recordCell(int i, Cell::Type t);
+  void ensureFood();
   unsigned nextRand();
-  int loadBestFromFile(const std::string& path);
-  void saveBestToFile(const std::string& path, int);
+  BestStore* store() const {
+    return own_store_ ? own_store_.get() : best_store_;
+  }
+  void syncBest();
   std::string defaultBestPath() const;
   void UpdateBest();
 };
 
+template <class Policy>
+RunResult Engine::run(int max_ticks, Policy&& policy) {
+  RunResult r;
+  if (state_ != State::kRunning) return r;
+  input_.clear();
+
+  const State prev_state = state_;
+  const int prev_score = score_, prev_best = best_, prev_level = level_;
+  r.reason = StopReason::kTickCap;
+  while (r.ticks < max_ticks) {
+    const Direction want = policy(static_cast<const Engine&>(*this));
+    if (!isOpposite(dir_, want)) dir_ = want;
+    step<false>();
+    ++r.ticks;
+    if (state_ != State::kRunning) {
+      r.reason = StopReason::kDeath;
+      break;
+    }
+    if (free_count_ == 0) {
+      r.reason = StopReason::kBoardFull;
+      break;
+    }
+  }
+  finishRun(prev_state, prev_score, prev_best, prev_level);
+  return r;
+}
+
 }  // namespace s21::snake
\ No newline at end of file
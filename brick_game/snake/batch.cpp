@@ -0,0 +1,214 @@
+#include "batch.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "batch_kernels.h"
+#include "rules.h"
+
+namespace s21::snake {
+
+static_assert(static_cast<int>(Direction::kUp) == 0 &&
+                  static_cast<int>(Direction::kDown) == 1 &&
+                  static_cast<int>(Direction::kLeft) == 2 &&
+                  static_cast<int>(Direction::kRight) == 3,
+              "batch kernels rely on the Direction encoding");
+
+SnakeBatch::SnakeBatch(int count, int width, int height, bool wrap)
+    : count_(count), w_(width), h_(height), wrap_(wrap) {
+  if (count < 0) throw std::invalid_argument("Negative batch size");
+  if (width <= 3 || height <= 3)
+    throw std::invalid_argument("Board too small");
+  if (width > std::numeric_limits<Coord>::max() ||
+      height > std::numeric_limits<Coord>::max())
+    throw std::invalid_argument("Board too large");
+
+  cells_ = w_ * h_;
+  words_ = (cells_ + 31) / 32;
+  const auto n = static_cast<std::size_t>(count_);
+  // AVX2 gather адресует битовые карты 32-битным смещением, а индексы
+  // клеток всех партий хранятся в int
+  if (n * static_cast<std::size_t>(cells_) >
+      static_cast<std::size_t>(std::numeric_limits<int>::max()))
+    throw std::invalid_argument("Batch too large");
+
+  state_.assign(n, static_cast<std::int32_t>(State::kGameOver));
+  dir_.assign(n, static_cast<std::int32_t>(Direction::kRight));
+  head_x_.assign(n, 0);
+  head_y_.assign(n, 0);
+  food_.assign(n, -1);
+  score_.assign(n, 0);
+  rng_.assign(n, pcg32_t{});
+  body_head_.assign(n, 0);
+  len_.assign(n, 0);
+  body_.assign(n * cells_, Point{});
+  occ_.assign(n * words_, 0);
+  free_cells_.assign(n * cells_, 0);
+  free_pos_.assign(n * cells_, -1);
+  free_count_.assign(n, 0);
+  actions_.assign(n, 0);
+  next_.assign(n, 0);
+  flags_.assign(n, 0);
+
+  setKernel(BatchKernel::kAuto);
+}
+
+bool SnakeBatch::kernelSupported(BatchKernel k) {
+  switch (k) {
+    case BatchKernel::kAuto:
+    case BatchKernel::kScalar:
+      return true;
+    case BatchKernel::kSse2:
+      return kernels::hasSse2();
+    case BatchKernel::kAvx2:
+      return kernels::hasAvx2();
+  }
+  return false;
+}
+
+bool SnakeBatch::setKernel(BatchKernel k) {
+  if (!kernelSupported(k)) return false;
+  if (k == BatchKernel::kAuto) k = BatchKernel::kScalar;
+  kernel_ = k;
+  return true;
+}
+
+void SnakeBatch::reset(int g, unsigned seed) {
+  game(g);
+  const std::size_t base = static_cast<std::size_t>(g) * cells_;
+  std::fill_n(occ_.begin() + static_cast<std::size_t>(g) * words_, words_, 0);
+  for (int i = 0; i < cells_; ++i)
+    free_cells_[base + i] = free_pos_[base + i] = i;
+  free_count_[g] = cells_;
+
+  body_head_[g] = 0;
+  len_[g] = 0;
+  rules::layInitialSnake(w_, h_, [&](int x, int y) {
+    body_[base + len_[g]++] = {static_cast<Coord>(x), static_cast<Coord>(y)};
+    occupy(g, y * w_ + x);
+  });
+  head_x_[g] = body_[base].x;
+  head_y_[g] = body_[base].y;
+
+  dir_[g] = static_cast<std::int32_t>(Direction::kRight);
+  score_[g] = 0;
+  rng_[g] = rules::seedState(seed);
+  spawnFood(g);
+  state_[g] = static_cast<std::int32_t>(State::kRunning);
+}
+
+void SnakeBatch::step(std::span<const Direction> actions) {
+  if (actions.size() != static_cast<std::size_t>(count_))
+    throw std::invalid_argument("One action per game expected");
+  for (int g = 0; g < count_; ++g)
+    actions_[g] = static_cast<std::int32_t>(actions[g]);
+
+  const kernels::Lanes lanes{state_.data(),
+                             static_cast<std::int32_t>(State::kRunning),
+                             dir_.data(),
+                             actions_.data(),
+                             head_x_.data(),
+                             head_y_.data(),
+                             food_.data(),
+                             occ_.data(),
+                             words_,
+                             w_,
+                             h_,
+                             wrap_,
+                             next_.data(),
+                             flags_.data()};
+  switch (kernel_) {
+    case BatchKernel::kAvx2:
+      kernels::advanceAvx2(lanes, 0, count_);
+      break;
+    case BatchKernel::kSse2:
+      kernels::advanceSse2(lanes, 0, count_);
+      break;
+    default:
+      kernels::advanceScalar(lanes, 0, count_);
+      break;
+  }
+
+  for (int g = 0; g < count_; ++g)
+    if (state_[g] == static_cast<std::int32_t>(State::kRunning)) commit(g);
+}
+
+void SnakeBatch::commit(int g) {
+  // Ядро уже нашло клетку головы и ее содержимое; дальше общие правила
+  struct Body {
+    SnakeBatch& b;
+    int g;
+    int tail() const {
+      const Point t = b.body_[b.bodyIndex(g, b.len_[g] - 1)];
+      return t.y * b.w_ + t.x;
+    }
+    void popTail(int i) {
+      b.release(g, i);
+      --b.len_[g];
+    }
+    void pushHead(int i) {
+      const int nx = i % b.w_, ny = i / b.w_;
+      int& head = b.body_head_[g];
+      head = head == 0 ? b.cells_ - 1 : head - 1;
+      b.body_[b.bodyIndex(g, 0)] = {static_cast<Coord>(nx),
+                                    static_cast<Coord>(ny)};
+      b.head_x_[g] = nx;
+      b.head_y_[g] = ny;
+      ++b.len_[g];
+      b.occupy(g, i);
+    }
+    void eat() {
+      ++b.score_[g];
+      b.spawnFood(g);
+    }
+  };
+  const std::uint8_t f = flags_[g];
+  if ((f & kernels::kWall) ||
+      !rules::advance(Body{*this, g}, next_[g], f & kernels::kGrow,
+                      f & kernels::kHit))
+    state_[g] = static_cast<std::int32_t>(State::kGameOver);
+}
+
+int SnakeBatch::level(int g) const {
+  return rules::levelForScore(score_[game(g)]);
+}
+
+Point SnakeBatch::segment(int g, int i) const {
+  if (i < 0 || i >= len_[game(g)])
+    throw std::out_of_range("No such segment");
+  return body_[bodyIndex(g, i)];
+}
+
+std::pair<int, int> SnakeBatch::food(int g) const {
+  if (food_[game(g)] < 0) return {-1, -1};
+  return {food_[g] % w_, food_[g] / w_};
+}
+
+Cell::Type SnakeBatch::cell(int g, int x, int y) const {
+  game(g);
+  if (x < 0 || x >= w_ || y < 0 || y >= h_)
+    throw std::out_of_range("Cell outside the board");
+  const int i = y * w_ + x;
+  if (occupied(g, i)) return Cell::kSnake;
+  return i == food_[g] ? Cell::kFood : Cell::kEmpty;
+}
+
+void SnakeBatch::occupy(int g, int i) {
+  const std::size_t base = static_cast<std::size_t>(g) * cells_;
+  occ_[static_cast<std::size_t>(g) * words_ + (i >> 5)] |= 1u << (i & 31);
+  rules::takeFree(&free_cells_[base], &free_pos_[base], free_count_[g], i);
+}
+
+void SnakeBatch::release(int g, int i) {
+  const std::size_t base = static_cast<std::size_t>(g) * cells_;
+  occ_[static_cast<std::size_t>(g) * words_ + (i >> 5)] &= ~(1u << (i & 31));
+  rules::putFree(&free_cells_[base], &free_pos_[base], free_count_[g], i);
+}
+
+void SnakeBatch::spawnFood(int g) {
+  const std::size_t base = static_cast<std::size_t>(g) * cells_;
+  food_[g] = rules::pickFoodCell(rng_[g], &free_cells_[base], free_count_[g]);
+}
+
+}  // namespace s21::snake
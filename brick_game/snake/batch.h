@@ -0,0 +1,179 @@
+/**
+ * @file batch.h
+ * @brief Пакетный движок Snake для обучения ботов
+ * @author BrickGame Team
+ * @version 2.0
+ * @date 2024
+ *
+ * @details
+ * SnakeBatch хранит N независимых партий одного размера в виде
+ * структуры массивов (головы, направления, счет, ГПСЧ, битовые карты
+ * поля) и продвигает их все одним вызовом step(). Правила берутся из
+ * rules.h, поэтому партия с тем же seed побитово совпадает с Engine,
+ * которому подают dispatch(kMove*) и dispatch(kTick).
+ *
+ * Тик делится на две фазы. Продвижение голов (направление, смещение,
+ * стены, занятость, еда) одинаково во всех партиях и может выполняться
+ * векторным ядром; запись тела и индекса свободных клеток — скалярно.
+ * Время тика уходит на вторую фазу, поэтому SSE2 и AVX2 не дают
+ * заметного выигрыша (BM_BatchStep) и включаются только явно.
+ */
+
+#pragma once
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "backend.h"
+
+namespace s21::snake {
+
+/**
+ * @enum BatchKernel
+ * @brief Реализация фазы продвижения голов
+ */
+enum class BatchKernel {
+  kAuto,    ///< По умолчанию: сейчас kScalar
+  kScalar,  ///< Переносимый скалярный код
+  kSse2,    ///< SSE2, 4 партии за итерацию
+  kAvx2     ///< AVX2, 8 партий за итерацию, занятость через gather
+};
+
+/**
+ * @class SnakeBatch
+ * @brief N партий Snake в формате структуры массивов
+ */
+class SnakeBatch {
+ public:
+  /**
+   * @brief Создать пакет партий
+   * @param count Число партий
+   * @param width,height Размеры поля (общие для всех партий)
+   * @param wrap Поле-тор, как Config::wrap
+   * @throw std::invalid_argument Неверные размеры или count * width *
+   *        height больше INT_MAX
+   */
+  SnakeBatch(int count, int width, int height, bool wrap = false);
+
+  /**
+   * @brief Начать партию заново, как Engine{seed} + dispatch(kStart)
+   * @param game Номер партии
+   * @param seed Семя ГПСЧ
+   * @throw std::out_of_range game вне [0, size())
+   */
+  void reset(int game, unsigned seed);
+
+  /**
+   * @brief Сделать один тик во всех идущих партиях
+   * @param actions Направление для каждой партии (size() элементов);
+   *                разворот на 180° игнорируется, как в Engine
+   * @throw std::invalid_argument actions.size() != size()
+   */
+  void step(std::span<const Direction> actions);
+
+  /**
+   * @brief Выбрать ядро продвижения голов
+   * @param k Ядро; kAuto — ядро по умолчанию
+   * @return false, если ядро не поддерживается процессором
+   */
+  bool setKernel(BatchKernel k);
+
+  /** @brief Используемое ядро (никогда не kAuto) */
+  BatchKernel kernel() const { return kernel_; }
+
+  /** @brief Поддерживается ли ядро на этой машине */
+  static bool kernelSupported(BatchKernel k);
+
+  int size() const { return count_; }
+  int width() const { return w_; }
+  int height() const { return h_; }
+  bool wrap() const { return wrap_; }
+
+  // Доступ к партии g: std::out_of_range, если g вне [0, size())
+  State state(int g) const { return static_cast<State>(state_[game(g)]); }
+  int score(int g) const { return score_[game(g)]; }
+  int level(int g) const;
+  int length(int g) const { return len_[game(g)]; }
+  Direction direction(int g) const {
+    return static_cast<Direction>(dir_[game(g)]);
+  }
+  Point head(int g) const {
+    game(g);
+    return {static_cast<Coord>(head_x_[g]), static_cast<Coord>(head_y_[g])};
+  }
+
+  /**
+   * @brief Сегмент тела (0 — голова)
+   * @throw std::out_of_range i вне [0, length(g))
+   */
+  Point segment(int g, int i) const;
+
+  /** @brief Координаты еды или {-1, -1} */
+  std::pair<int, int> food(int g) const;
+
+  /** @brief Число свободных клеток партии */
+  int freeCells(int g) const { return free_count_[game(g)]; }
+
+  /**
+   * @brief Содержимое клетки партии
+   * @throw std::out_of_range Клетка вне поля
+   */
+  Cell::Type cell(int g, int x, int y) const;
+
+  /**
+   * @brief Наблюдения всех партий (observation.h), тензор N x C x H x W
+   * @param out size() * observationSize(W, H) элементов
+   * @return false, если буфер мал; память не выделяется
+   */
+  bool observe(std::span<std::uint8_t> out) const;
+
+  /** @brief То же в float */
+  bool observe(std::span<float> out) const;
+
+ private:
+  int count_, w_, h_, cells_, words_;
+  bool wrap_;
+  BatchKernel kernel_{BatchKernel::kScalar};
+
+  std::vector<std::int32_t> state_;    ///< State каждой партии
+  std::vector<std::int32_t> dir_;      ///< Direction каждой партии
+  std::vector<std::int32_t> head_x_;   ///< X головы
+  std::vector<std::int32_t> head_y_;   ///< Y головы
+  std::vector<std::int32_t> food_;     ///< Индекс клетки еды или -1
+  std::vector<int> score_;             ///< Счет
+  std::vector<pcg32_t> rng_;           ///< Состояние ГПСЧ
+  std::vector<int> body_head_;         ///< Индекс головы в кольце тела
+  std::vector<int> len_;               ///< Длина змейки
+  std::vector<Point> body_;            ///< Кольца тел, cells_ на партию
+  std::vector<std::uint32_t> occ_;     ///< Битовые карты, words_ на партию
+  std::vector<int> free_cells_;        ///< Индексы свободных клеток
+  std::vector<int> free_pos_;          ///< Позиции клеток в free_cells_
+  std::vector<int> free_count_;        ///< Число свободных клеток
+  std::vector<std::int32_t> actions_;  ///< Действия текущего тика
+  std::vector<std::int32_t> next_;     ///< Новая клетка головы
+  std::vector<std::uint8_t> flags_;    ///< kernels::LaneFlag
+
+  int game(int g) const {
+    if (g < 0 || g >= count_) throw std::out_of_range("No such game");
+    return g;
+  }
+  std::size_t bodyIndex(int g, int i) const {
+    int j = body_head_[g] + i;
+    if (j >= cells_) j -= cells_;
+    return static_cast<std::size_t>(g) * cells_ + j;
+  }
+  bool occupied(int g, int i) const {
+    return (occ_[static_cast<std::size_t>(g) * words_ + (i >> 5)] >>
+            (i & 31)) & 1u;
+  }
+  void occupy(int g, int i);
+  void release(int g, int i);
+  void spawnFood(int g);
+  void commit(int g);
+  template <class T>
+  bool observeInto(std::span<T> out) const;
+};
+
+}  // namespace s21::snake
@@ -0,0 +1,235 @@
+#include "batch_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define S21_SNAKE_X86 1
+#endif
+
+namespace s21::snake::kernels {
+
+// Направления кодируются как в Direction: 0 — вверх, 1 — вниз, 2 — влево,
+// 3 — вправо. Противоположные пары отличаются только младшим битом.
+
+void advanceScalar(const Lanes& l, int begin, int end) {
+  const int wrap_w = l.wrap ? l.width : 0;
+  const int wrap_h = l.wrap ? l.height : 0;
+  for (int g = begin; g < end; ++g) {
+    if (l.state[g] != l.running) {
+      l.next[g] = 0;
+      l.flags[g] = 0;
+      continue;
+    }
+    int d = l.dir[g];
+    if ((d ^ l.actions[g]) != 1) d = l.actions[g];
+    l.dir[g] = d;
+
+    int nx = l.head_x[g] + (d == 3) - (d == 2);
+    int ny = l.head_y[g] + (d == 1) - (d == 0);
+    nx += (wrap_w & -(nx < 0)) - (wrap_w & -(nx >= l.width));
+    ny += (wrap_h & -(ny < 0)) - (wrap_h & -(ny >= l.height));
+    if (nx < 0 || nx >= l.width || ny < 0 || ny >= l.height) {
+      l.next[g] = 0;
+      l.flags[g] = kWall;
+      continue;
+    }
+
+    const int ni = ny * l.width + nx;
+    const std::uint32_t word =
+        l.occ[static_cast<std::size_t>(g) * l.occ_words + (ni >> 5)];
+    std::uint8_t f = 0;
+    if ((word >> (ni & 31)) & 1u) f |= kHit;
+    if (ni == l.food[g]) f |= kGrow;
+    l.next[g] = ni;
+    l.flags[g] = f;
+  }
+}
+
+#ifdef S21_SNAKE_X86
+
+namespace {
+
+__attribute__((target("sse2"))) inline __m128i mullo32(__m128i a, __m128i b) {
+  // В SSE2 нет _mm_mullo_epi32: перемножаем четные и нечетные дорожки
+  __m128i even = _mm_mul_epu32(a, b);
+  __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+__attribute__((target("sse2"))) inline __m128i load4(const std::int32_t* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+__attribute__((target("avx2"))) inline __m256i load8(const std::int32_t* p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+}  // namespace
+
+__attribute__((target("sse2"))) void advanceSse2(const Lanes& l, int begin,
+                                                 int end) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i one = _mm_set1_epi32(1);
+  const __m128i two = _mm_set1_epi32(2);
+  const __m128i three = _mm_set1_epi32(3);
+  const __m128i running = _mm_set1_epi32(l.running);
+  const __m128i width = _mm_set1_epi32(l.width);
+  const __m128i max_x = _mm_set1_epi32(l.width - 1);
+  const __m128i max_y = _mm_set1_epi32(l.height - 1);
+  const __m128i wrap_w = _mm_set1_epi32(l.wrap ? l.width : 0);
+  const __m128i wrap_h = _mm_set1_epi32(l.wrap ? l.height : 0);
+  const __m128i wall_flag = _mm_set1_epi32(kWall);
+  const __m128i grow_flag = _mm_set1_epi32(kGrow);
+  alignas(16) std::int32_t flags[4];
+
+  int g = begin;
+  for (; g + 4 <= end; g += 4) {
+    const __m128i alive = _mm_cmpeq_epi32(load4(l.state + g), running);
+    const __m128i d = load4(l.dir + g);
+    const __m128i a = load4(l.actions + g);
+    const __m128i opp = _mm_cmpeq_epi32(_mm_xor_si128(d, a), one);
+    __m128i nd = _mm_or_si128(_mm_and_si128(opp, d), _mm_andnot_si128(opp, a));
+    nd = _mm_or_si128(_mm_and_si128(alive, nd), _mm_andnot_si128(alive, d));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(l.dir + g), nd);
+
+    const __m128i dx =
+        _mm_sub_epi32(_mm_cmpeq_epi32(nd, two), _mm_cmpeq_epi32(nd, three));
+    const __m128i dy =
+        _mm_sub_epi32(_mm_cmpeq_epi32(nd, zero), _mm_cmpeq_epi32(nd, one));
+    __m128i nx = _mm_add_epi32(load4(l.head_x + g), dx);
+    __m128i ny = _mm_add_epi32(load4(l.head_y + g), dy);
+    nx = _mm_sub_epi32(
+        _mm_add_epi32(nx, _mm_and_si128(_mm_cmplt_epi32(nx, zero), wrap_w)),
+        _mm_and_si128(_mm_cmpgt_epi32(nx, max_x), wrap_w));
+    ny = _mm_sub_epi32(
+        _mm_add_epi32(ny, _mm_and_si128(_mm_cmplt_epi32(ny, zero), wrap_h)),
+        _mm_and_si128(_mm_cmpgt_epi32(ny, max_y), wrap_h));
+    const __m128i wall = _mm_and_si128(
+        alive,
+        _mm_or_si128(_mm_or_si128(_mm_cmplt_epi32(nx, zero),
+                                  _mm_cmpgt_epi32(nx, max_x)),
+                     _mm_or_si128(_mm_cmplt_epi32(ny, zero),
+                                  _mm_cmpgt_epi32(ny, max_y))));
+    const __m128i valid = _mm_andnot_si128(wall, alive);
+    const __m128i ni =
+        _mm_and_si128(valid, _mm_add_epi32(mullo32(ny, width), nx));
+    const __m128i grow =
+        _mm_and_si128(valid, _mm_cmpeq_epi32(ni, load4(l.food + g)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(l.next + g), ni);
+    _mm_store_si128(reinterpret_cast<__m128i*>(flags),
+                    _mm_or_si128(_mm_and_si128(wall, wall_flag),
+                                 _mm_and_si128(grow, grow_flag)));
+
+    for (int k = 0; k < 4; ++k) {
+      std::uint8_t f = static_cast<std::uint8_t>(flags[k]);
+      const int lane = g + k;
+      if (l.state[lane] == l.running && !(f & kWall)) {
+        const int i = l.next[lane];
+        const std::size_t w =
+            static_cast<std::size_t>(lane) * l.occ_words + (i >> 5);
+        if ((l.occ[w] >> (i & 31)) & 1u) f |= kHit;
+      }
+      l.flags[lane] = f;
+    }
+  }
+  advanceScalar(l, g, end);
+}
+
+__attribute__((target("avx2"))) void advanceAvx2(const Lanes& l, int begin,
+                                                 int end) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i two = _mm256_set1_epi32(2);
+  const __m256i three = _mm256_set1_epi32(3);
+  const __m256i bit_mask = _mm256_set1_epi32(31);
+  const __m256i running = _mm256_set1_epi32(l.running);
+  const __m256i width = _mm256_set1_epi32(l.width);
+  const __m256i max_x = _mm256_set1_epi32(l.width - 1);
+  const __m256i max_y = _mm256_set1_epi32(l.height - 1);
+  const __m256i wrap_w = _mm256_set1_epi32(l.wrap ? l.width : 0);
+  const __m256i wrap_h = _mm256_set1_epi32(l.wrap ? l.height : 0);
+  const __m256i words = _mm256_set1_epi32(l.occ_words);
+  const __m256i wall_flag = _mm256_set1_epi32(kWall);
+  const __m256i hit_flag = _mm256_set1_epi32(kHit);
+  const __m256i grow_flag = _mm256_set1_epi32(kGrow);
+  const __m256i lane_offsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  alignas(32) std::int32_t flags[8];
+
+  int g = begin;
+  for (; g + 8 <= end; g += 8) {
+    const __m256i alive = _mm256_cmpeq_epi32(load8(l.state + g), running);
+    const __m256i d = load8(l.dir + g);
+    const __m256i a = load8(l.actions + g);
+    const __m256i opp = _mm256_cmpeq_epi32(_mm256_xor_si256(d, a), one);
+    __m256i nd = _mm256_blendv_epi8(a, d, opp);
+    nd = _mm256_blendv_epi8(d, nd, alive);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(l.dir + g), nd);
+
+    const __m256i dx = _mm256_sub_epi32(_mm256_cmpeq_epi32(nd, two),
+                                        _mm256_cmpeq_epi32(nd, three));
+    const __m256i dy = _mm256_sub_epi32(_mm256_cmpeq_epi32(nd, zero),
+                                        _mm256_cmpeq_epi32(nd, one));
+    __m256i nx = _mm256_add_epi32(load8(l.head_x + g), dx);
+    __m256i ny = _mm256_add_epi32(load8(l.head_y + g), dy);
+    nx = _mm256_sub_epi32(
+        _mm256_add_epi32(
+            nx, _mm256_and_si256(_mm256_cmpgt_epi32(zero, nx), wrap_w)),
+        _mm256_and_si256(_mm256_cmpgt_epi32(nx, max_x), wrap_w));
+    ny = _mm256_sub_epi32(
+        _mm256_add_epi32(
+            ny, _mm256_and_si256(_mm256_cmpgt_epi32(zero, ny), wrap_h)),
+        _mm256_and_si256(_mm256_cmpgt_epi32(ny, max_y), wrap_h));
+    const __m256i wall = _mm256_and_si256(
+        alive, _mm256_or_si256(_mm256_or_si256(_mm256_cmpgt_epi32(zero, nx),
+                                               _mm256_cmpgt_epi32(nx, max_x)),
+                               _mm256_or_si256(_mm256_cmpgt_epi32(zero, ny),
+                                               _mm256_cmpgt_epi32(ny, max_y))));
+    const __m256i valid = _mm256_andnot_si256(wall, alive);
+    const __m256i ni = _mm256_and_si256(
+        valid, _mm256_add_epi32(_mm256_mullo_epi32(ny, width), nx));
+    const __m256i grow =
+        _mm256_and_si256(valid, _mm256_cmpeq_epi32(ni, load8(l.food + g)));
+
+    // Слово битовой карты каждой партии читается одним gather
+    const __m256i lane = _mm256_add_epi32(_mm256_set1_epi32(g), lane_offsets);
+    const __m256i word_idx = _mm256_add_epi32(_mm256_mullo_epi32(lane, words),
+                                              _mm256_srli_epi32(ni, 5));
+    const __m256i word = _mm256_mask_i32gather_epi32(
+        zero, reinterpret_cast<const int*>(l.occ), word_idx, valid, 4);
+    const __m256i bit = _mm256_and_si256(
+        _mm256_srlv_epi32(word, _mm256_and_si256(ni, bit_mask)), one);
+    const __m256i hit = _mm256_and_si256(valid, _mm256_cmpeq_epi32(bit, one));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(l.next + g), ni);
+    _mm256_store_si256(
+        reinterpret_cast<__m256i*>(flags),
+        _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(wall, wall_flag),
+                                        _mm256_and_si256(hit, hit_flag)),
+                        _mm256_and_si256(grow, grow_flag)));
+    for (int k = 0; k < 8; ++k)
+      l.flags[g + k] = static_cast<std::uint8_t>(flags[k]);
+  }
+  advanceScalar(l, g, end);
+}
+
+bool hasSse2() { return __builtin_cpu_supports("sse2"); }
+
+bool hasAvx2() { return __builtin_cpu_supports("avx2"); }
+
+#else
+
+void advanceSse2(const Lanes& l, int begin, int end) {
+  advanceScalar(l, begin, end);
+}
+
+void advanceAvx2(const Lanes& l, int begin, int end) {
+  advanceScalar(l, begin, end);
+}
+
+bool hasSse2() { return false; }
+
+bool hasAvx2() { return false; }
+
+#endif
+
+}  // namespace s21::snake::kernels
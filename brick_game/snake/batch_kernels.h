@@ -0,0 +1,61 @@
+/**
+ * @file batch_kernels.h
+ * @brief Внутренние ядра SnakeBatch: фаза продвижения голов
+ * @author BrickGame Team
+ * @version 2.0
+ * @date 2024
+ *
+ * @details
+ * Фаза продвижения одинакова во всех партиях: выбор направления,
+ * смещение головы, проверка стен, индекс клетки, сравнение с едой и
+ * чтение бита занятости. Она выполняется векторно (SSE2/AVX2) или
+ * скалярно; запись тела и индекса свободных клеток остается скалярной.
+ * На торе координата оборачивается маской, без отдельной ветки.
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace s21::snake::kernels {
+
+/** @brief Флаги результата продвижения для одной партии */
+enum LaneFlag : std::uint8_t {
+  kWall = 1,  ///< Голова вышла за границу поля
+  kHit = 2,   ///< Клетка занята телом (до учета уходящего хвоста)
+  kGrow = 4,  ///< Голова попадает на еду
+};
+
+/** @brief Указатели на массивы пакета для диапазона партий */
+struct Lanes {
+  const std::int32_t* state;    ///< Состояния партий
+  std::int32_t running;         ///< Значение State::kRunning
+  std::int32_t* dir;            ///< Направления (обновляются)
+  const std::int32_t* actions;  ///< Желаемые направления
+  const std::int32_t* head_x;   ///< X головы
+  const std::int32_t* head_y;   ///< Y головы
+  const std::int32_t* food;     ///< Индекс клетки еды или -1
+  const std::uint32_t* occ;     ///< Битовые карты как 32-битные слова
+  int occ_words;                ///< 32-битных слов на партию; все
+                                ///< карты вместе — не больше INT_MAX слов
+  int width, height;            ///< Размеры поля
+  bool wrap;                    ///< Поле-тор: стен нет
+  std::int32_t* next;           ///< Выход: индекс новой клетки головы
+  std::uint8_t* flags;          ///< Выход: LaneFlag
+};
+
+/** @brief Скалярная реализация для партий [begin, end) */
+void advanceScalar(const Lanes& l, int begin, int end);
+
+/** @brief SSE2: продвижение по 4 партии, занятость скалярно */
+void advanceSse2(const Lanes& l, int begin, int end);
+
+/** @brief AVX2: продвижение по 8 партий, занятость через gather */
+void advanceAvx2(const Lanes& l, int begin, int end);
+
+/** @brief Доступен ли SSE2 на этой машине */
+bool hasSse2();
+
+/** @brief Доступен ли AVX2 на этой машине */
+bool hasAvx2();
+
+}  // namespace s21::snake::kernels
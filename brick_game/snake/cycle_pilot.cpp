@@ -0,0 +1,78 @@
+#include "cycle_pilot.h"
+
+#include <stdexcept>
+
+#include "rules.h"
+
+namespace s21::snake {
+
+CyclePilot::CyclePilot(int width, int height) : w_(width), h_(height) {
+  if (w_ < 4 || h_ < 4) throw std::invalid_argument("Board too small");
+  if (w_ % 2 && h_ % 2)
+    throw std::invalid_argument("Hamiltonian cycle needs an even side");
+
+  // Цикл строится по строкам поля cw x ch с четной высотой ch; при
+  // нечетной высоте настоящего поля — по транспонированному
+  const bool by_rows = h_ % 2 == 0;
+  const int cw = by_rows ? w_ : h_, ch = by_rows ? h_ : w_;
+  // Начальная змейка лежит в строке H / 2 головой вправо: строка должна
+  // проходиться слева направо, иначе цикл отражается по вертикали.
+  // По столбцам порядок и так растет с x
+  const bool mirror = by_rows && (h_ / 2) % 2 == 1;
+  order_.assign(static_cast<std::size_t>(w_) * h_, 0);
+  int k = 0;
+  auto put = [&](int x, int y) {
+    if (mirror) y = ch - 1 - y;
+    order_[by_rows ? y * w_ + x : x * w_ + y] = k++;
+  };
+
+  put(0, 0);
+  for (int y = 0; y < ch; ++y) {
+    if (y % 2 == 0)
+      for (int x = 1; x < cw; ++x) put(x, y);
+    else
+      for (int x = cw - 1; x >= 1; --x) put(x, y);
+  }
+  for (int y = ch - 1; y >= 1; --y) put(0, y);
+}
+
+Direction CyclePilot::decide(const Engine& e) const {
+  if (e.width() != w_ || e.height() != h_) return e.direction();
+  const int n = w_ * h_;
+  const Point head = e.head();
+  const int at = order_[head.y * w_ + head.x];
+  // Сколько шагов по циклу от головы до клетки
+  auto ahead = [&](int x, int y) {
+    const int d = order_[y * w_ + x] - at;
+    return d < 0 ? d + n : d;
+  };
+  const Point tail = e.tail();
+  const int to_tail = ahead(tail.x, tail.y);
+  const auto [fx, fy] = e.food();
+  const int to_food = fx >= 0 ? ahead(fx, fy) : n;
+
+  Direction best = e.direction();
+  int best_step = 0;
+  for (Direction d : {Direction::kUp, Direction::kDown, Direction::kLeft,
+                      Direction::kRight}) {
+    int x = head.x + rules::deltaX(d), y = head.y + rules::deltaY(d);
+    if (e.wrap()) {
+      x = rules::wrapCoord(x, w_, 0);
+      y = rules::wrapCoord(y, h_, 0);
+    } else if (x < 0 || x >= w_ || y < 0 || y >= h_) {
+      continue;
+    }
+    // Следующая клетка цикла допустима всегда; срез — только раньше
+    // хвоста и не дальше еды
+    const int step = ahead(x, y);
+    const bool ok = step == 1 || (step < to_tail && step <= to_food &&
+                                  !e.isSnakeCell(x, y));
+    if (ok && step > best_step) {
+      best = d;
+      best_step = step;
+    }
+  }
+  return best;
+}
+
+}  // namespace s21::snake
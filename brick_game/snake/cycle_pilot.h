@@ -0,0 +1,63 @@
+/**
+ * @file cycle_pilot.h
+ * @brief Автопилот по гамильтонову циклу: заполняет поле целиком
+ * @author BrickGame Team
+ * @version 2.0
+ * @date 2024
+ *
+ * @details
+ * Цикл проходит все клетки поля, поэтому змейка, идущая по нему, не
+ * умирает и доедает поле до конца. Нужна хотя бы одна четная сторона:
+ * при четной высоте цикл идет «змейкой» по строкам и возвращается по
+ * столбцу x = 0, иначе — по столбцам с возвратом по строке y = 0.
+ * Цикл ориентирован так, чтобы начальная змейка движка уже лежала на
+ * нем по порядку: хвост, затем голова.
+ *
+ * Срезы. Пока тело лежит на цикле по порядку от хвоста к голове,
+ * клетки цикла впереди головы до хвоста свободны. Поэтому можно
+ * шагнуть на любую соседнюю клетку, которая впереди по циклу, но ближе
+ * хвоста: порядок сохраняется, а хвост без роста отступает минимум на
+ * клетку за тик. Из таких ходов выбирается самый дальний, не
+ * перепрыгивающий еду. Решение стоит O(1), так что даже на поле
+ * 100x100 время прогона уходит в сам движок: пилот служит генератором
+ * нагрузки для длинных змеек.
+ */
+
+#pragma once
+#include <vector>
+
+#include "backend.h"
+
+namespace s21::snake {
+
+/**
+ * @class CyclePilot
+ * @brief Гамильтонов цикл с безопасными срезами
+ */
+class CyclePilot {
+ public:
+  /**
+   * @brief Построить цикл для поля
+   * @throw std::invalid_argument Обе стороны нечетные или поле меньше 4x4
+   */
+  CyclePilot(int width, int height);
+
+  /**
+   * @brief Ход на следующий тик
+   * @param e Партия того же размера, начатая под управлением пилота
+   * @return Направление; текущее, если поле другого размера
+   */
+  Direction decide(const Engine& e) const;
+
+  /** @brief То же: объект служит стратегией для Engine::run() */
+  Direction operator()(const Engine& e) const { return decide(e); }
+
+  /** @brief Номер клетки на цикле (0 .. width * height - 1) */
+  int cycleIndex(int x, int y) const { return order_[y * w_ + x]; }
+
+ private:
+  int w_, h_;
+  std::vector<int> order_;  ///< Номер клетки на цикле по индексу y * w + x
+};
+
+}  // namespace s21::snake
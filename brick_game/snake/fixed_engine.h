@@ -0,0 +1,286 @@
+/**
+ * @file fixed_engine.h
+ * @brief Движок Snake с размером поля, заданным при компиляции
+ * @author BrickGame Team
+ * @version 2.0
+ * @date 2024
+ *
+ * @details
+ * FixedEngine<W, H> играет по тем же правилам, что Engine (rules.h), и с
+ * тем же seed дает ту же партию, но хранит все состояние в std::array
+ * внутри объекта, а индексы клеток считает от констант. Если строка
+ * помещается в 64 бита, занятость хранится по строкам: rows_[y] — биты
+ * клеток строки y.
+ *
+ * Движок предназначен для прогонов без интерфейса: он не ведет байтовое
+ * поле, список изменений и файл рекорда. Объект большого поля занимает
+ * десятки килобайт, поэтому такие экземпляры лучше держать в куче.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "backend.h"
+#include "rules.h"
+
+namespace s21::snake {
+
+/**
+ * @class FixedEngine
+ * @brief Игровой движок Snake для поля W x H
+ * @tparam W Ширина поля
+ * @tparam H Высота поля
+ */
+template <int W, int H>
+class FixedEngine {
+  static_assert(W > 3 && H > 3, "Board too small");
+  static_assert(W <= std::numeric_limits<Coord>::max() &&
+                    H <= std::numeric_limits<Coord>::max(),
+                "Board too large");
+
+ public:
+  static constexpr int kWidth = W;
+  static constexpr int kHeight = H;
+  static constexpr int kCells = W * H;
+  /// Занятость хранится строками uint64_t
+  static constexpr bool kRowBits = W <= 64;
+
+  /**
+   * @brief Создать движок, как Engine{Config{W, H, seed, wrap}}
+   * @param seed Семя ГПСЧ
+   * @param wrap Поле-тор
+   */
+  explicit FixedEngine(unsigned seed = 0, bool wrap = false);
+
+  State state() const { return state_; }
+
+  /** @brief Обработать событие (те же переходы, что у Engine) */
+  void dispatch(Event e);
+
+  /**
+   * @brief Прокрутить игру без интерфейса, как Engine::run()
+   * @param max_ticks Предел тиков
+   * @param policy policy(const FixedEngine&) -> Direction
+   */
+  template <class Policy>
+  RunResult run(int max_ticks, Policy&& policy);
+
+  Point head() const { return body_[head_]; }
+  Point tail() const { return body_[wrapBody(head_ + len_ - 1)]; }
+  /** @brief Сегмент тела (0 — голова) */
+  Point segment(int i) const { return body_[wrapBody(head_ + i)]; }
+  Direction direction() const { return dir_; }
+  std::size_t queuedMoves() const { return input_.size(); }
+  std::pair<int, int> food() const { return food_; }
+  std::size_t length() const { return static_cast<std::size_t>(len_); }
+  std::size_t freeCells() const {
+    return static_cast<std::size_t>(free_count_);
+  }
+  int score() const { return score_; }
+  /** @brief Лучший счет за время жизни объекта (без файла) */
+  int best() const { return best_; }
+  int level() const { return level_; }
+  int speedMs() const { return speed_ms_; }
+
+  /** @brief Занята ли клетка змейкой (false за пределами поля) */
+  bool isSnakeCell(int x, int y) const {
+    if (x < 0 || x >= W || y < 0 || y >= H) return false;
+    return occupied(x, y);
+  }
+
+  /** @brief Содержимое клетки */
+  Cell::Type cell(int x, int y) const {
+    if (occupied(x, y)) return Cell::kSnake;
+    return food_.first == x && food_.second == y ? Cell::kFood : Cell::kEmpty;
+  }
+
+ private:
+  static constexpr int kWords = kRowBits ? H : (kCells + 63) / 64;
+  static constexpr int kMaskX = rules::wrapMask(W);
+  static constexpr int kMaskY = rules::wrapMask(H);
+
+  static constexpr int idx(int x, int y) { return y * W + x; }
+  static constexpr int wrapBody(int i) { return i >= kCells ? i - kCells : i; }
+  static constexpr Point pointAt(int i) {
+    return {static_cast<Coord>(i % W), static_cast<Coord>(i / W)};
+  }
+
+  bool occupied(int x, int y) const {
+    if constexpr (kRowBits)
+      return (occ_[y] >> x) & 1u;
+    else
+      return (occ_[idx(x, y) >> 6] >> (idx(x, y) & 63)) & 1u;
+  }
+  void setOccupied(int x, int y, bool on) {
+    std::uint64_t* word;
+    int bit;
+    if constexpr (kRowBits) {
+      word = &occ_[y];
+      bit = x;
+    } else {
+      word = &occ_[idx(x, y) >> 6];
+      bit = idx(x, y) & 63;
+    }
+    if (on)
+      *word |= std::uint64_t{1} << bit;
+    else
+      *word &= ~(std::uint64_t{1} << bit);
+  }
+  void occupy(Point p) {
+    setOccupied(p.x, p.y, true);
+    rules::takeFree(free_cells_.data(), free_pos_.data(), free_count_,
+                    idx(p.x, p.y));
+  }
+  void release(Point p) {
+    setOccupied(p.x, p.y, false);
+    rules::putFree(free_cells_.data(), free_pos_.data(), free_count_,
+                   idx(p.x, p.y));
+  }
+
+  void placeInitialSnake();
+  void spawnFood();
+  void ensureFood();
+  void recompute() {
+    level_ = rules::levelForScore(score_);
+    speed_ms_ = rules::speedForLevel(level_);
+  }
+  void gameOver() {
+    state_ = State::kGameOver;
+    if (score_ > best_) best_ = score_;
+  }
+  void step();
+
+  bool wrap_;
+  State state_{State::kInit};
+  Direction dir_{Direction::kRight};
+  InputQueue input_;
+  std::array<Point, kCells> body_{};         ///< Кольцо тела
+  int head_{0};                              ///< Индекс головы в body_
+  int len_{0};                               ///< Длина змейки
+  std::array<std::uint64_t, kWords> occ_{};  ///< Битовая карта занятости
+  std::array<int, kCells> free_cells_{};     ///< Плотный список свободных
+  std::array<int, kCells> free_pos_{};       ///< Позиции в free_cells_
+  int free_count_{0};
+  std::pair<int, int> food_{-1, -1};
+  rules::Rng rng_state_{};
+  int score_{0};
+  int best_{0};
+  int level_{1};
+  int speed_ms_{200};
+};
+
+template <int W, int H>
+FixedEngine<W, H>::FixedEngine(unsigned seed, bool wrap) : wrap_(wrap) {
+  placeInitialSnake();
+  rng_state_ = rules::seedState(seed);
+  spawnFood();
+}
+
+template <int W, int H>
+void FixedEngine<W, H>::placeInitialSnake() {
+  // Тот же порядок индекса свободных клеток, что в Engine
+  occ_.fill(0);
+  free_count_ = kCells;
+  for (int i = 0; i < kCells; ++i) free_cells_[i] = free_pos_[i] = i;
+  head_ = 0;
+  len_ = 0;
+  rules::layInitialSnake(W, H, [this](int x, int y) {
+    body_[len_++] = {static_cast<Coord>(x), static_cast<Coord>(y)};
+    occupy(body_[len_ - 1]);
+  });
+  dir_ = Direction::kRight;
+  input_.clear();
+  state_ = State::kInit;
+}
+
+template <int W, int H>
+void FixedEngine<W, H>::spawnFood() {
+  const int i =
+      rules::pickFoodCell(rng_state_, free_cells_.data(), free_count_);
+  if (i < 0)
+    food_ = {-1, -1};
+  else
+    food_ = {i % W, i / W};
+}
+
+template <int W, int H>
+void FixedEngine<W, H>::ensureFood() {
+  if (food_.first < 0 || occupied(food_.first, food_.second)) spawnFood();
+}
+
+template <int W, int H>
+void FixedEngine<W, H>::dispatch(Event e) {
+  rules::dispatch(
+      e, state_, dir_, input_,
+      [this](State) {
+        placeInitialSnake();
+        ensureFood();
+        score_ = 0;
+        recompute();
+      },
+      [this] { step(); });
+}
+
+template <int W, int H>
+void FixedEngine<W, H>::step() {
+  int nx = head().x, ny = head().y;
+  if (!rules::stepHead(nx, ny, dir_, W, H, wrap_, kMaskX, kMaskY)) {
+    gameOver();
+    return;
+  }
+  struct Body {
+    FixedEngine& e;
+    int tail() const {
+      const Point t = e.tail();
+      return idx(t.x, t.y);
+    }
+    void popTail(int i) {
+      e.release(pointAt(i));
+      --e.len_;
+    }
+    void pushHead(int i) {
+      e.head_ = e.head_ == 0 ? kCells - 1 : e.head_ - 1;
+      e.body_[e.head_] = pointAt(i);
+      ++e.len_;
+      e.occupy(e.body_[e.head_]);
+    }
+    void eat() {
+      ++e.score_;
+      e.recompute();
+      e.spawnFood();
+    }
+  };
+  const bool grows = food_.first == nx && food_.second == ny;
+  if (!rules::advance(Body{*this}, idx(nx, ny), grows, occupied(nx, ny)))
+    gameOver();
+}
+
+template <int W, int H>
+template <class Policy>
+RunResult FixedEngine<W, H>::run(int max_ticks, Policy&& policy) {
+  RunResult r;
+  if (state_ != State::kRunning) return r;
+  input_.clear();
+  r.reason = StopReason::kTickCap;
+  while (r.ticks < max_ticks) {
+    const Direction want = policy(static_cast<const FixedEngine&>(*this));
+    if (!rules::isOpposite(dir_, want)) dir_ = want;
+    step();
+    ++r.ticks;
+    if (state_ != State::kRunning) {
+      r.reason = StopReason::kDeath;
+      break;
+    }
+    if (free_count_ == 0) {
+      r.reason = StopReason::kBoardFull;
+      break;
+    }
+  }
+  return r;
+}
+
+}  // namespace s21::snake
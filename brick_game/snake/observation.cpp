@@ -0,0 +1,83 @@
+#include "observation.h"
+
+#include "batch.h"
+
+namespace s21::snake {
+
+namespace {
+
+template <class T>
+bool observeEngine(const Engine& e, std::span<T> out) {
+  const SnapshotView v = e.view();
+  if (out.size() < observationSize(v.width, v.height)) return false;
+  obs::writePlanes(out.data(), v.width, v.height, v.snake, e.head(), v.food,
+                   e.direction());
+  return true;
+}
+
+template <class T>
+bool observeEngines(std::span<const Engine* const> engines,
+                    std::span<T> out) {
+  if (engines.empty()) return true;
+  const SnapshotView first = engines[0]->view();
+  const std::size_t n = observationSize(first.width, first.height);
+  if (out.size() < n * engines.size()) return false;
+  for (const Engine* e : engines) {
+    const SnapshotView v = e->view();
+    if (v.width != first.width || v.height != first.height) return false;
+  }
+  for (std::size_t i = 0; i < engines.size(); ++i)
+    (void)observeEngine(*engines[i], out.subspan(i * n, n));
+  return true;
+}
+
+}  // namespace
+
+bool Engine::observe(std::span<std::uint8_t> out) const {
+  return observeEngine(*this, out);
+}
+
+bool Engine::observe(std::span<float> out) const {
+  return observeEngine(*this, out);
+}
+
+bool observeBatch(std::span<const Engine* const> engines,
+                  std::span<std::uint8_t> out) {
+  return observeEngines(engines, out);
+}
+
+bool observeBatch(std::span<const Engine* const> engines,
+                  std::span<float> out) {
+  return observeEngines(engines, out);
+}
+
+template <class T>
+bool SnakeBatch::observeInto(std::span<T> out) const {
+  const std::size_t n = observationSize(w_, h_);
+  if (out.size() < n * static_cast<std::size_t>(count_)) return false;
+  for (int g = 0; g < count_; ++g) {
+    if (len_[g] == 0) {
+      // Партия еще ни разу не начиналась: пустое наблюдение
+      std::fill_n(out.data() + g * n, n, T{0});
+      continue;
+    }
+    // Тело партии — кольцо из cells_ точек, голова по индексу body_head_
+    const Point* ring = body_.data() + static_cast<std::size_t>(g) * cells_;
+    const int first = std::min(len_[g], cells_ - body_head_[g]);
+    const BodyView body{{ring + body_head_[g], ring + body_head_[g] + first},
+                        {ring, ring + (len_[g] - first)}};
+    obs::writePlanes(out.data() + g * n, w_, h_, body, head(g), food(g),
+                     direction(g));
+  }
+  return true;
+}
+
+bool SnakeBatch::observe(std::span<std::uint8_t> out) const {
+  return observeInto(out);
+}
+
+bool SnakeBatch::observe(std::span<float> out) const {
+  return observeInto(out);
+}
+
+}  // namespace s21::snake
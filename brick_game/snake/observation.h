@@ -0,0 +1,102 @@
+/**
+ * @file observation.h
+ * @brief Наблюдение для обучающихся агентов: one-hot плоскости поля
+ * @author BrickGame Team
+ * @version 2.0
+ * @date 2024
+ *
+ * @details
+ * Наблюдение партии — kObsPlanes плоскостей H x W подряд (порядок CHW):
+ * тело (вместе с головой), голова, еда и четыре плоскости направления,
+ * из которых единицами целиком заполнена только текущая. Значения 0 и
+ * 1 пишутся как uint8 или float прямо в буфер вызывающего, без
+ * промежуточного Snapshot и без выделения памяти. Пакетные версии
+ * кладут наблюдения партий друг за другом в один тензор N x C x H x W.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include "backend.h"
+
+namespace s21::snake {
+
+/**
+ * @enum ObsPlane
+ * @brief Номер плоскости в наблюдении
+ */
+enum class ObsPlane {
+  kBody,     ///< Все клетки змейки
+  kHead,     ///< Голова
+  kFood,     ///< Еда
+  kDirUp,    ///< Направление kUp (плоскость целиком)
+  kDirDown,  ///< Направление kDown
+  kDirLeft,  ///< Направление kLeft
+  kDirRight  ///< Направление kRight
+};
+
+/** @brief Число плоскостей в наблюдении */
+inline constexpr int kObsPlanes = 7;
+
+/** @brief Размер наблюдения одной партии в элементах */
+constexpr std::size_t observationSize(int width, int height) {
+  return static_cast<std::size_t>(kObsPlanes) * width * height;
+}
+
+/**
+ * @brief Наблюдения нескольких движков одним тензором N x C x H x W
+ * @param engines Движки с полем одного размера
+ * @param out Буфер на engines.size() * observationSize(W, H) элементов
+ * @return false, если буфер мал или размеры полей различаются
+ */
+bool observeBatch(std::span<const Engine* const> engines,
+                  std::span<std::uint8_t> out);
+
+/** @brief То же в float */
+bool observeBatch(std::span<const Engine* const> engines,
+                  std::span<float> out);
+
+namespace obs {
+
+static_assert(static_cast<int>(Direction::kUp) == 0 &&
+                  static_cast<int>(Direction::kDown) == 1 &&
+                  static_cast<int>(Direction::kLeft) == 2 &&
+                  static_cast<int>(Direction::kRight) == 3,
+              "direction planes follow the Direction encoding");
+
+/**
+ * @brief Записать наблюдение одной партии
+ * @param out Начало observationSize(w, h) элементов
+ * @param body Тело змейки (голова включительно)
+ * @param head Голова
+ * @param food Еда или {-1, -1}
+ * @param dir Текущее направление
+ */
+template <class T>
+void writePlanes(T* out, int w, int h, const BodyView& body, Point head,
+                 std::pair<int, int> food, Direction dir) {
+  const std::size_t cells = static_cast<std::size_t>(w) * h;
+  auto plane = [&](ObsPlane p) {
+    return out + static_cast<std::size_t>(p) * cells;
+  };
+  std::fill(out, out + observationSize(w, h), T{0});
+
+  T* const b = plane(ObsPlane::kBody);
+  for (const Point& p : body.head_part) b[p.y * w + p.x] = T{1};
+  for (const Point& p : body.tail_part) b[p.y * w + p.x] = T{1};
+  plane(ObsPlane::kHead)[head.y * w + head.x] = T{1};
+  if (food.first >= 0)
+    plane(ObsPlane::kFood)[food.second * w + food.first] = T{1};
+
+  T* const d = plane(static_cast<ObsPlane>(
+      static_cast<int>(ObsPlane::kDirUp) + static_cast<int>(dir)));
+  std::fill(d, d + cells, T{1});
+}
+
+}  // namespace obs
+
+}  // namespace s21::snake
@@ -0,0 +1,129 @@
+#include "replay.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+#include "varint.h"
+
+namespace s21::snake {
+
+namespace {
+
+constexpr std::uint8_t kMagic[] = {'S', '2', '1', 'R'};
+// Версия 2: ГПСЧ PCG32; реплеи версии 1 шли на xorshift и не воспроизводятся
+constexpr std::uint8_t kVersion = 2;
+constexpr std::uint8_t kEndMarker = 0xFF;
+constexpr std::uint64_t kWrapFlag = 1;
+// Пределы недоверенного файла: поле до 2048x2048 (десятки мегабайт
+// движка) и до 2^24 тиков между событиями (больше 11 суток игры на
+// самой высокой скорости)
+constexpr std::uint64_t kMaxCells = std::uint64_t{1} << 22;
+constexpr std::uint64_t kMaxTickRun = std::uint64_t{1} << 24;
+
+}  // namespace
+
+ReplayRecorder::ReplayRecorder(const Config& cfg) {
+  out_.assign(std::begin(kMagic), std::end(kMagic));
+  out_.push_back(kVersion);
+  varint::put(out_, static_cast<std::uint64_t>(cfg.width));
+  varint::put(out_, static_cast<std::uint64_t>(cfg.height));
+  varint::put(out_, cfg.seed);
+  varint::put(out_, cfg.wrap ? kWrapFlag : 0);
+}
+
+void ReplayRecorder::record(Event e) {
+  if (finished_) return;
+  if (e == Event::kTick) {
+    ++pending_ticks_;
+    return;
+  }
+  varint::put(out_, pending_ticks_);
+  out_.push_back(static_cast<std::uint8_t>(e));
+  pending_ticks_ = 0;
+}
+
+void ReplayRecorder::finish(int final_score) {
+  if (finished_) return;
+  varint::put(out_, pending_ticks_);
+  out_.push_back(kEndMarker);
+  varint::put(out_, static_cast<std::uint64_t>(std::max(final_score, 0)));
+  finished_ = true;
+}
+
+bool ReplayRecorder::save(const std::string& path) const {
+  std::ofstream f(path, std::ios::binary | std::ios::trunc);
+  if (!f) return false;
+  f.write(reinterpret_cast<const char*>(out_.data()),
+          static_cast<std::streamsize>(out_.size()));
+  return static_cast<bool>(f);
+}
+
+bool loadReplay(const std::string& path, std::vector<std::uint8_t>& data) {
+  std::ifstream f(path, std::ios::binary);
+  if (!f) return false;
+  data.assign(std::istreambuf_iterator<char>(f),
+              std::istreambuf_iterator<char>());
+  return !f.bad();
+}
+
+ReplayResult playReplay(std::span<const std::uint8_t> data) {
+  ReplayResult res;
+  varint::Reader in(data);
+
+  for (std::uint8_t m : kMagic) {
+    std::uint8_t b;
+    if (!in.byte(b) || b != m) return res;
+  }
+  std::uint8_t version;
+  std::uint64_t w, h, seed, flags;
+  if (!in.byte(version) || version != kVersion || !in.value(w) ||
+      !in.value(h) || !in.value(seed) || !in.value(flags))
+    return res;
+  if (w > 0x7FFF || h > 0x7FFF || w * h > kMaxCells || seed > 0xFFFFFFFFu)
+    return res;
+
+  Config cfg;
+  cfg.width = static_cast<int>(w);
+  cfg.height = static_cast<int>(h);
+  cfg.seed = static_cast<unsigned>(seed);
+  cfg.wrap = (flags & kWrapFlag) != 0;
+  cfg.persist = false;
+
+  try {
+    Engine e{cfg};
+    for (;;) {
+      std::uint64_t delta;
+      std::uint8_t ev;
+      if (!in.value(delta, kMaxTickRun) || !in.byte(ev)) return res;
+      // Вне kRunning тик ничего не меняет: остаток серии пропускается
+      for (std::uint64_t t = 0; t < delta && e.state() == State::kRunning; ++t)
+        e.dispatch(Event::kTick);
+      res.ticks += delta;
+
+      if (ev == kEndMarker) {
+        std::uint64_t score;
+        if (!in.value(score, std::numeric_limits<int>::max()) || !in.atEnd())
+          return res;
+        res.recorded_score = static_cast<int>(score);
+        break;
+      }
+      if (ev > static_cast<std::uint8_t>(Event::kQuit)) return res;
+      e.dispatch(static_cast<Event>(ev));
+    }
+    res.valid = true;
+    res.score = e.view().score;
+    res.state = e.state();
+    res.score_matches = res.score == res.recorded_score;
+  } catch (const std::invalid_argument&) {
+    res.valid = false;
+  } catch (const std::bad_alloc&) {
+    res.valid = false;
+  }
+  return res;
+}
+
+}  // namespace s21::snake
@@ -0,0 +1,90 @@
+/**
+ * @file replay.h
+ * @brief Компактная запись партий Snake и их воспроизведение
+ * @author BrickGame Team
+ * @version 2.0
+ * @date 2024
+ *
+ * @details
+ * Партия полностью определяется Config (размер, seed, wrap) и потоком
+ * событий: еда ставится детерминированным PCG32 из rules::seedState().
+ * Поэтому реплей хранит только их:
+ *
+ *     "S21R" версия
+ *     varint width, height, seed, flags (бит 0 — wrap)
+ *     записи: varint число kTick до события, байт Event
+ *     конец:  varint число оставшихся kTick, байт 0xFF, varint счет
+ *
+ * varint — беззнаковый LEB128. kTick не пишутся как события, а
+ * учитываются счетчиком, так что тысячи тиков без нажатий занимают пару
+ * байт. Файл считается недоверенным: поле больше 2^22 клеток, серия
+ * больше 2^24 тиков и счет вне int отвергаются.
+ */
+
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "backend.h"
+
+namespace s21::snake {
+
+/**
+ * @class ReplayRecorder
+ * @brief Пишет реплей параллельно с Engine
+ *
+ * @details
+ * Каждое событие, отданное движку, нужно передать и в record().
+ */
+class ReplayRecorder {
+ public:
+  /** @brief Начать запись партии с конфигурацией cfg */
+  explicit ReplayRecorder(const Config& cfg);
+
+  /** @brief Учесть событие, переданное Engine::dispatch() */
+  void record(Event e);
+
+  /**
+   * @brief Закрыть запись итоговым счетом
+   * @details После finish() record() игнорируется.
+   */
+  void finish(int final_score);
+
+  /** @brief Байты реплея */
+  const std::vector<std::uint8_t>& bytes() const { return out_; }
+
+  /** @brief Сохранить реплей в файл; false при ошибке ввода-вывода */
+  bool save(const std::string& path) const;
+
+ private:
+  std::vector<std::uint8_t> out_;
+  std::uint64_t pending_ticks_{0};  ///< kTick после последней записи
+  bool finished_{false};
+};
+
+/**
+ * @struct ReplayResult
+ * @brief Итог воспроизведения
+ */
+struct ReplayResult {
+  bool valid{false};          ///< Файл разобран целиком
+  bool score_matches{false};  ///< Итоговый счет совпал с записанным
+  int recorded_score{0};      ///< Счет из реплея
+  int score{0};               ///< Счет после воспроизведения
+  std::uint64_t ticks{0};     ///< Воспроизведено тиков
+  State state{State::kInit};  ///< Состояние движка в конце
+};
+
+/**
+ * @brief Воспроизвести реплей с максимальной скоростью
+ * @param data Байты реплея
+ * @return valid = false для поврежденных или обрезанных данных
+ */
+ReplayResult playReplay(std::span<const std::uint8_t> data);
+
+/** @brief Прочитать файл реплея; false при ошибке ввода-вывода */
+bool loadReplay(const std::string& path, std::vector<std::uint8_t>& data);
+
+}  // namespace s21::snake
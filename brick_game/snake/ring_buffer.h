@@ -0,0 +1,135 @@
+/**
+ * @file ring_buffer.h
+ * @brief Кольцевой буфер фиксированной емкости для тела змейки
+ * @author BrickGame Team
+ * @version 2.0
+ * @date 2024
+ *
+ * @details
+ * Емкость задается один раз (W*H клеток поля), после чего операции
+ * push_front/pop_back/clear не выделяют память. Индекс 0 — голова.
+ */
+
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace s21::snake {
+
+/**
+ * @class RingBuffer
+ * @brief Двусторонняя очередь на заранее выделенном массиве
+ * @tparam T Тип элемента
+ */
+template <class T>
+class RingBuffer {
+ public:
+  /**
+   * @class const_iterator
+   * @brief Итератор от головы к хвосту
+   */
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    const_iterator() = default;
+    const_iterator(const RingBuffer* rb, std::size_t i) : rb_(rb), i_(i) {}
+
+    reference operator*() const { return (*rb_)[i_]; }
+    pointer operator->() const { return &(*rb_)[i_]; }
+    const_iterator& operator++() {
+      ++i_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator t = *this;
+      ++i_;
+      return t;
+    }
+    bool operator==(const const_iterator& o) const { return i_ == o.i_; }
+    bool operator!=(const const_iterator& o) const { return i_ != o.i_; }
+
+   private:
+    const RingBuffer* rb_{nullptr};
+    std::size_t i_{0};
+  };
+
+  /**
+   * @brief Выделить память под capacity элементов и очистить буфер
+   * @param capacity Максимальное число элементов
+   */
+  void reset(std::size_t capacity) {
+    data_.assign(capacity, T{});
+    clear();
+  }
+
+  /** @brief Удалить все элементы (память сохраняется) */
+  void clear() {
+    head_ = 0;
+    size_ = 0;
+  }
+
+  /** @brief Добавить элемент в начало (голова) */
+  void push_front(const T& v) {
+    head_ = head_ == 0 ? data_.size() - 1 : head_ - 1;
+    data_[head_] = v;
+    ++size_;
+  }
+
+  /** @brief Добавить элемент в конец (хвост) */
+  void push_back(const T& v) {
+    data_[wrap(head_ + size_)] = v;
+    ++size_;
+  }
+
+  /** @brief Удалить последний элемент (хвост) */
+  void pop_back() { --size_; }
+
+  const T& front() const { return data_[head_]; }
+  const T& back() const { return data_[wrap(head_ + size_ - 1)]; }
+
+  /**
+   * @brief Доступ по индексу от головы
+   * @param i 0 — голова, size()-1 — хвост
+   */
+  const T& operator[](std::size_t i) const { return data_[wrap(head_ + i)]; }
+
+  std::size_t size() const { return size_; }
+  std::size_t capacity() const { return data_.size(); }
+  bool empty() const { return size_ == 0; }
+
+  /**
+   * @brief Непрерывный участок от головы до конца хранилища
+   * @details Вместе с tailSegment() покрывает все элементы по порядку.
+   */
+  std::span<const T> headSegment() const {
+    std::size_t n = data_.size() - head_;
+    return {data_.data() + head_, size_ < n ? size_ : n};
+  }
+
+  /** @brief Продолжение тела с начала хранилища (пусто без переноса) */
+  std::span<const T> tailSegment() const {
+    std::size_t n = data_.size() - head_;
+    return {data_.data(), size_ > n ? size_ - n : 0};
+  }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size_); }
+
+ private:
+  std::size_t wrap(std::size_t i) const {
+    return i >= data_.size() ? i - data_.size() : i;
+  }
+
+  std::vector<T> data_;   ///< Хранилище фиксированной емкости
+  std::size_t head_{0};   ///< Индекс головы в data_
+  std::size_t size_{0};   ///< Текущее число элементов
+};
+
+}  // namespace s21::snake
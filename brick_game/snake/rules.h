@@ -0,0 +1,269 @@
+/**
+ * @file rules.h
+ * @brief Общие правила игры Snake
+ * @author BrickGame Team
+ * @version 2.0
+ * @date 2024
+ *
+ * @details
+ * Правила, которые используют все реализации движка (Engine,
+ * FixedEngine, SnakeBatch): автомат состояний, начальная раскладка, ход
+ * головы со столкновениями, уходом хвоста и ростом, выбор еды. Хранение
+ * у движков разное, поэтому правила с изменением состояния — шаблоны,
+ * а доступ к полю и телу движок передает объектом или лямбдами.
+ * Благодаря единому источнику правил партии с одинаковым seed дают
+ * побитово одинаковый результат.
+ */
+
+#pragma once
+#include "../common/pcg32.h"
+#include "backend.h"
+
+namespace s21::snake::rules {
+
+/// Состояние ГПСЧ партии (brick_game/common/pcg32.h)
+using Rng = pcg32_t;
+
+/**
+ * @brief Начальное состояние ГПСЧ для seed
+ * @details seed выбирает и поток PCG, поэтому партии с разными seed
+ * (например, first_seed + i в runner.h) идут по независимым
+ * последовательностям, а не по сдвигам одной.
+ */
+inline Rng seedState(unsigned seed) {
+  Rng r;
+  pcg32_seed(&r, seed, seed);
+  return r;
+}
+
+/** @brief Следующее 32-битное число */
+inline unsigned nextRand(Rng& rng) { return pcg32_next(&rng); }
+
+/** @brief Равномерное число в [0, n) без смещения остатка */
+inline int bounded(Rng& rng, int n) {
+  return static_cast<int>(pcg32_bounded(&rng, static_cast<std::uint32_t>(n)));
+}
+
+/// Определена в backend.h рядом с Direction: ее использует InputQueue
+using snake::isOpposite;
+
+/** @brief Событие поворота в направлении d */
+inline Event moveEvent(Direction d) {
+  switch (d) {
+    case Direction::kUp:
+      return Event::kMoveUp;
+    case Direction::kDown:
+      return Event::kMoveDown;
+    case Direction::kLeft:
+      return Event::kMoveLeft;
+    case Direction::kRight:
+      break;
+  }
+  return Event::kMoveRight;
+}
+
+/** @brief Направление поворота для события kMove* */
+inline Direction moveDirection(Event e) {
+  switch (e) {
+    case Event::kMoveUp:
+      return Direction::kUp;
+    case Event::kMoveDown:
+      return Direction::kDown;
+    case Event::kMoveLeft:
+      return Direction::kLeft;
+    default:
+      break;
+  }
+  return Direction::kRight;
+}
+
+/** @brief Смещение по X для направления */
+inline int deltaX(Direction d) {
+  return d == Direction::kRight ? 1 : d == Direction::kLeft ? -1 : 0;
+}
+
+/** @brief Смещение по Y для направления */
+inline int deltaY(Direction d) {
+  return d == Direction::kDown ? 1 : d == Direction::kUp ? -1 : 0;
+}
+
+/**
+ * @brief Маска быстрого обертывания
+ * @return n - 1, если n — степень двойки, иначе 0
+ */
+constexpr int wrapMask(int n) { return (n & (n - 1)) == 0 ? n - 1 : 0; }
+
+/**
+ * @brief Обернуть координату после шага на ±1 без ветвлений
+ * @param v Координата в диапазоне [-1, n]
+ * @param n Размер поля по оси
+ * @param mask wrapMask(n): для степени двойки хватает одного AND
+ */
+constexpr int wrapCoord(int v, int n, int mask) {
+  if (mask) return v & mask;
+  v += n & -static_cast<int>(v < 0);
+  return v - (n & -static_cast<int>(v >= n));
+}
+
+/**
+ * @brief Шаг головы на соседнюю клетку
+ * @param x,y Голова; на выходе — новая клетка
+ * @param d Направление
+ * @param w,h Размеры поля
+ * @param wrap Поле-тор
+ * @param mask_x,mask_y wrapMask(w), wrapMask(h)
+ * @return false, если голова уходит в стену
+ */
+inline bool stepHead(int& x, int& y, Direction d, int w, int h, bool wrap,
+                     int mask_x, int mask_y) {
+  x += deltaX(d);
+  y += deltaY(d);
+  // На торе координата переходит на противоположный край без ветвлений
+  if (wrap) {
+    x = wrapCoord(x, w, mask_x);
+    y = wrapCoord(y, h, mask_y);
+    return true;
+  }
+  return x >= 0 && x < w && y >= 0 && y < h;
+}
+
+/// Длина змейки в начале партии
+inline constexpr int kInitialLength = 3;
+
+/**
+ * @brief Начальная змейка: голова в центре поля, тело влево от нее
+ * @param put put(x, y) для каждого сегмента от головы к хвосту
+ */
+template <class Put>
+void layInitialSnake(int w, int h, Put&& put) {
+  const int cx = w / 2, cy = h / 2;
+  for (int k = 0; k < kInitialLength; ++k) put(cx - k, cy);
+}
+
+/** @brief Уровень для счета (1..10, каждые 5 очков) */
+inline int levelForScore(int score) {
+  int lvl = 1 + score / 5;
+  return lvl > 10 ? 10 : lvl;
+}
+
+/** @brief Интервал тика для уровня, мс */
+inline int speedForLevel(int level) {
+  int ms = 200 - (level - 1) * 15;
+  return ms < 60 ? 60 : ms;
+}
+
+/**
+ * @brief Занять клетку в индексе свободных клеток (swap-remove)
+ * @param cells Плотный массив свободных клеток
+ * @param pos Позиция каждой клетки в cells (-1 — занята)
+ * @param count Число свободных клеток, уменьшается на 1
+ * @param i Индекс клетки
+ */
+inline void takeFree(int* cells, int* pos, int& count, int i) {
+  int p = pos[i];
+  int last = cells[--count];
+  cells[p] = last;
+  pos[last] = p;
+  pos[i] = -1;
+}
+
+/** @brief Вернуть клетку в индекс свободных клеток */
+inline void putFree(int* cells, int* pos, int& count, int i) {
+  pos[i] = count;
+  cells[count++] = i;
+}
+
+/**
+ * @brief Выбрать клетку для еды
+ * @details Равномерно среди свободных клеток: одно число ГПСЧ на выбор.
+ * @param rng Состояние ГПСЧ
+ * @param cells,count Индекс свободных клеток
+ * @return Индекс клетки или -1, если поле заполнено
+ */
+inline int pickFoodCell(Rng& rng, const int* cells, int count) {
+  return count == 0 ? -1 : cells[bounded(rng, count)];
+}
+
+/**
+ * @brief Ход головы на соседнюю клетку
+ *
+ * @details
+ * Хвост освобождает клетку в этот же тик, если змейка не растет,
+ * поэтому голова может занять его текущую позицию; в остальных случаях
+ * занятая клетка — столкновение. Хранилище тела (Body) предоставляет:
+ * - tail() — индекс клетки хвоста;
+ * - popTail(i) — убрать хвост с клетки i;
+ * - pushHead(i) — новая голова на клетке i;
+ * - eat() — счет и новая еда после роста.
+ *
+ * @param body Хранилище тела
+ * @param next Индекс клетки головы после stepHead()
+ * @param grows На клетке еда
+ * @param hit Клетка занята змейкой
+ * @return false — змейка врезалась в себя, состояние не изменилось
+ */
+template <class Body>
+bool advance(Body&& body, int next, bool grows, bool hit) {
+  const int tail = body.tail();
+  if (hit && (grows || tail != next)) return false;
+  if (!grows) body.popTail(tail);
+  body.pushHead(next);
+  if (grows) body.eat();
+  return true;
+}
+
+/**
+ * @brief Переходы автомата состояний по событию
+ *
+ * @details
+ * kStart начинает партию из kInit, kReady и kGameOver; kReset готовит
+ * новую партию в kReady из любого состояния; повороты копятся в очереди
+ * только во время игры, а kTick забирает из нее один поворот и делает
+ * ход.
+ *
+ * @param e Событие
+ * @param state,dir,input Состояние, направление и очередь поворотов
+ * @param restart restart(State next): новая партия (змейка, еда, счет)
+ *        перед переходом в next
+ * @param step step(): ход в направлении dir
+ */
+template <class Restart, class Step>
+void dispatch(Event e, State& state, Direction& dir, InputQueue& input,
+              Restart&& restart, Step&& step) {
+  switch (e) {
+    case Event::kStart:
+      if (state == State::kInit || state == State::kReady ||
+          state == State::kGameOver) {
+        restart(State::kRunning);
+        state = State::kRunning;
+      }
+      break;
+    case Event::kReset:
+      restart(State::kReady);
+      state = State::kReady;
+      break;
+    case Event::kPauseToggle:
+      if (state == State::kRunning)
+        state = State::kPaused;
+      else if (state == State::kPaused)
+        state = State::kRunning;
+      break;
+    case Event::kMoveUp:
+    case Event::kMoveDown:
+    case Event::kMoveLeft:
+    case Event::kMoveRight:
+      // Поворот применится на своем тике; разворот отсекается очередью
+      if (state == State::kRunning) input.push(dir, moveDirection(e));
+      break;
+    case Event::kTick:
+      if (state == State::kRunning) {
+        dir = input.next(dir);
+        step();
+      }
+      break;
+    case Event::kQuit:
+      break;
+  }
+}
+
+}  // namespace s21::snake::rules
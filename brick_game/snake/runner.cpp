@@ -0,0 +1,175 @@
+#include "runner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace s21::snake {
+
+namespace {
+
+/// Полуинтервал номеров партий
+struct Range {
+  std::uint64_t begin, end;
+};
+
+/**
+ * @brief Очередь кусков одного потока
+ *
+ * @details
+ * Владелец берет куски с конца, воры — с начала. Куски крупные (chunk
+ * партий), поэтому мьютекс на очередь не становится узким местом.
+ */
+class WorkQueue {
+ public:
+  void push(Range r) {
+    std::lock_guard<std::mutex> lock(m_);
+    q_.push_back(r);
+  }
+
+  bool pop(Range& r) {
+    std::lock_guard<std::mutex> lock(m_);
+    if (q_.empty()) return false;
+    r = q_.back();
+    q_.pop_back();
+    return true;
+  }
+
+  bool steal(Range& r) {
+    std::lock_guard<std::mutex> lock(m_);
+    if (q_.empty()) return false;
+    r = q_.front();
+    q_.pop_front();
+    return true;
+  }
+
+ private:
+  std::mutex m_;
+  std::deque<Range> q_;
+};
+
+double mean(std::uint64_t sum, std::uint64_t n) {
+  return n ? static_cast<double>(sum) / static_cast<double>(n) : 0.0;
+}
+
+}  // namespace
+
+void RunStats::add(const GameResult& r) {
+  const auto score = static_cast<std::uint64_t>(r.score);
+  ++games;
+  deaths += r.died ? 1 : 0;
+  sum_score += score;
+  sum_score_sq += score * score;
+  sum_length += static_cast<std::uint64_t>(r.length);
+  sum_ticks += static_cast<std::uint64_t>(r.ticks);
+  max_score = std::max(max_score, r.score);
+  max_length = std::max(max_length, r.length);
+  max_ticks = std::max(max_ticks, r.ticks);
+}
+
+void RunStats::merge(const RunStats& o) {
+  games += o.games;
+  deaths += o.deaths;
+  sum_score += o.sum_score;
+  sum_score_sq += o.sum_score_sq;
+  sum_length += o.sum_length;
+  sum_ticks += o.sum_ticks;
+  max_score = std::max(max_score, o.max_score);
+  max_length = std::max(max_length, o.max_length);
+  max_ticks = std::max(max_ticks, o.max_ticks);
+}
+
+double RunStats::meanScore() const { return mean(sum_score, games); }
+double RunStats::meanLength() const { return mean(sum_length, games); }
+double RunStats::meanTicks() const { return mean(sum_ticks, games); }
+
+double RunStats::scoreStddev() const {
+  if (games == 0) return 0.0;
+  const double m = meanScore();
+  const double var = mean(sum_score_sq, games) - m * m;
+  return var > 0 ? std::sqrt(var) : 0.0;
+}
+
+GameResult playGame(const Config& board, const Policy& policy, int max_ticks) {
+  Engine e{board};
+  e.dispatch(Event::kStart);
+
+  GameResult r;
+  r.ticks = e.run(max_ticks, policy).ticks;
+  r.score = e.view().score;
+  r.length = static_cast<int>(e.length());
+  r.died = e.state() == State::kGameOver;
+  return r;
+}
+
+RunStats runGames(const RunnerConfig& cfg, const Policy& policy) {
+  int threads = cfg.threads > 0
+                    ? cfg.threads
+                    : static_cast<int>(std::thread::hardware_concurrency());
+  threads = std::max(threads, 1);
+  const std::uint64_t chunk = std::max<std::uint64_t>(cfg.chunk, 1);
+
+  // Каждому потоку — свой непрерывный отрезок партий, нарезанный на куски
+  std::vector<WorkQueue> queues(threads);
+  const std::uint64_t per_thread = (cfg.games + threads - 1) / threads;
+  for (int t = 0; t < threads; ++t) {
+    const std::uint64_t lo = std::min(cfg.games, per_thread * t);
+    const std::uint64_t hi = std::min(cfg.games, lo + per_thread);
+    for (std::uint64_t b = lo; b < hi; b += chunk)
+      queues[t].push({b, std::min(hi, b + chunk)});
+  }
+
+  std::vector<RunStats> partial(threads);
+  std::vector<std::exception_ptr> errors(threads);
+  auto worker = [&](int id) {
+    try {
+      // Аккумулятор локален: соседние элементы partial делили бы линию
+      // кэша, а обновляются после каждой партии
+      RunStats local;
+      Config board = cfg.board;
+      Range r;
+      for (;;) {
+        // Новых кусков не появляется: если пусты все очереди, работа сделана
+        bool found = queues[id].pop(r);
+        for (int k = 1; !found && k < threads; ++k)
+          found = queues[(id + k) % threads].steal(r);
+        if (!found) break;
+        for (std::uint64_t g = r.begin; g < r.end; ++g) {
+          board.seed = cfg.first_seed + static_cast<unsigned>(g);
+          local.add(playGame(board, policy, cfg.max_ticks));
+        }
+      }
+      partial[id] = local;
+    } catch (...) {
+      errors[id] = std::current_exception();
+    }
+  };
+
+  // Если std::thread не создастся, уже запущенные потоки дожидаются в
+  // деструкторе: joinable std::thread вызвал бы std::terminate
+  struct Pool {
+    std::vector<std::thread> threads;
+    ~Pool() {
+      for (auto& th : threads)
+        if (th.joinable()) th.join();
+    }
+  } pool;
+  pool.threads.reserve(threads - 1);
+  for (int t = 1; t < threads; ++t) pool.threads.emplace_back(worker, t);
+  worker(0);
+  for (auto& th : pool.threads) th.join();
+
+  for (auto& err : errors)
+    if (err) std::rethrow_exception(err);
+
+  RunStats total;
+  for (const auto& p : partial) total.merge(p);
+  return total;
+}
+
+}  // namespace s21::snake
@@ -0,0 +1,105 @@
+/**
+ * @file runner.h
+ * @brief Массовый прогон партий Snake без интерфейса
+ * @author BrickGame Team
+ * @version 2.0
+ * @date 2024
+ *
+ * @details
+ * Партии с seed = first_seed + i раздаются пулу потоков кусками по chunk
+ * штук. Каждый поток берет куски из своей очереди, а опустев, крадет их
+ * из чужих. Статистика копится в аккумуляторе потока и сливается в конце;
+ * все поля — суммы и максимумы целых чисел, поэтому итог не зависит ни
+ * от числа потоков, ни от порядка выполнения.
+ */
+
+#pragma once
+#include <cstdint>
+#include <functional>
+
+#include "backend.h"
+
+namespace s21::snake {
+
+/**
+ * @brief Стратегия бота: направление на следующий тик
+ *
+ * @details
+ * Вызывается одновременно из нескольких потоков, поэтому не должна
+ * изменять общее состояние. Результат может зависеть только от партии,
+ * иначе прогон перестанет быть воспроизводимым. Партии крутятся через
+ * Engine::run(), поэтому читать поле нужно через isSnakeCell(), а не
+ * через view().
+ */
+using Policy = std::function<Direction(const Engine&)>;
+
+/**
+ * @struct GameResult
+ * @brief Итог одной партии
+ */
+struct GameResult {
+  int score{0};          ///< Счет
+  int length{0};         ///< Длина змейки в конце
+  int ticks{0};          ///< Прожито тиков
+  bool died{false};      ///< true — GameOver, false — упор в max_ticks
+};
+
+/**
+ * @struct RunStats
+ * @brief Сводная статистика прогона
+ */
+struct RunStats {
+  std::uint64_t games{0};         ///< Сыграно партий
+  std::uint64_t deaths{0};        ///< Закончились GameOver
+  std::uint64_t sum_score{0};     ///< Сумма счета
+  std::uint64_t sum_score_sq{0};  ///< Сумма квадратов счета
+  std::uint64_t sum_length{0};    ///< Сумма финальной длины
+  std::uint64_t sum_ticks{0};     ///< Сумма прожитых тиков
+  int max_score{0};               ///< Лучший счет
+  int max_length{0};              ///< Наибольшая длина
+  int max_ticks{0};               ///< Самая долгая партия
+
+  /** @brief Учесть одну партию */
+  void add(const GameResult& r);
+
+  /** @brief Слить статистику другого аккумулятора */
+  void merge(const RunStats& o);
+
+  double meanScore() const;
+  double meanLength() const;
+  double meanTicks() const;
+  double scoreStddev() const;
+
+  bool operator==(const RunStats&) const = default;
+};
+
+/**
+ * @struct RunnerConfig
+ * @brief Параметры прогона
+ */
+struct RunnerConfig {
+  /// Поле; seed игнорируется. По умолчанию без сохранения рекорда;
+  /// общий рекорд прогона собирает persist = true и MemoryBestStore
+  Config board{20, 20, 0, false, {}, false};
+  std::uint64_t games{1000};      ///< Число партий
+  unsigned first_seed{1};         ///< seed партии i = first_seed + i
+  int max_ticks{100000};          ///< Предел тиков на партию
+  int threads{0};                 ///< Потоков; 0 — по числу ядер
+  std::uint64_t chunk{64};        ///< Партий в одном куске работы
+};
+
+/**
+ * @brief Сыграть одну партию
+ * @param board Поле (вместе с seed)
+ * @param policy Стратегия
+ * @param max_ticks Предел тиков
+ */
+GameResult playGame(const Config& board, const Policy& policy, int max_ticks);
+
+/**
+ * @brief Сыграть cfg.games партий на пуле потоков
+ * @return Статистика, одинаковая при любом cfg.threads
+ */
+RunStats runGames(const RunnerConfig& cfg, const Policy& policy);
+
+}  // namespace s21::snake
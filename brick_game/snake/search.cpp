@@ -0,0 +1,200 @@
+#include "search.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "rules.h"
+
+namespace s21::snake {
+
+bool BoardSearch::prepare(const Engine& e, Point from, bool tail_free) {
+  w_ = e.width();
+  h_ = e.height();
+  wrap_ = e.wrap();
+  full_ = w_ >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << w_) - 1;
+  occ_ = e.occupancy().data();
+  const Point t = e.tail();
+  tail_ = tail_free ? t.y * w_ + t.x : -1;
+
+  // resize() не выделяет память, пока размер поля не растет
+  const std::size_t cells = static_cast<std::size_t>(w_) * h_;
+  dist_.resize(cells);
+  if (bitboard()) {
+    free_.resize(h_);
+    reach_.resize(h_);
+    frontier_.resize(h_);
+    next_.resize(h_);
+  } else {
+    queue_.resize(cells);
+  }
+  return from.x >= 0 && from.x < w_ && from.y >= 0 && from.y < h_;
+}
+
+void BoardSearch::loadRows() {
+  for (int y = 0; y < h_; ++y) {
+    // Строка — w_ бит битовой карты начиная с y * w_, не более двух слов
+    const int off = y * w_;
+    const int word = off >> 6, shift = off & 63;
+    std::uint64_t row = occ_[word] >> shift;
+    if (shift && shift + w_ > 64) row |= occ_[word + 1] << (64 - shift);
+    free_[y] = ~row & full_;
+  }
+  if (tail_ >= 0) free_[tail_ / w_] |= std::uint64_t{1} << (tail_ % w_);
+}
+
+std::uint64_t BoardSearch::spreadRow(std::uint64_t r) const {
+  std::uint64_t s = (r << 1) | (r >> 1);
+  if (wrap_) s |= (r << (w_ - 1)) | (r >> (w_ - 1));
+  return s & full_;
+}
+
+std::uint64_t BoardSearch::fillRow(std::uint64_t s, std::uint64_t f) const {
+  // Заполнение Когге — Стоуна: за шаг k заливка проходит 2^k клеток
+  // через свободный отрезок, так что 6 шагов покрывают слово целиком
+  auto fill = [](std::uint64_t gen, std::uint64_t pro) {
+    std::uint64_t up = gen, down = gen, pro_up = pro, pro_down = pro;
+    for (int k = 1; k < 64; k <<= 1) {
+      up |= pro_up & (up << k);
+      pro_up &= pro_up << k;
+      down |= pro_down & (down >> k);
+      pro_down &= pro_down >> k;
+    }
+    return up | down;
+  };
+  s = fill(s, f);
+  if (wrap_) {
+    // Отрезок, упершийся в край, продолжается с другого края строки
+    const std::uint64_t edge =
+        (((s & 1u) << (w_ - 1)) | ((s >> (w_ - 1)) & 1u)) & f & ~s;
+    if (edge) s = fill(s | edge, f);
+  }
+  return s;
+}
+
+void BoardSearch::neighbors(const std::vector<std::uint64_t>& from,
+                            std::vector<std::uint64_t>& out) const {
+  for (int y = 0; y < h_; ++y) {
+    std::uint64_t n = spreadRow(from[y]);
+    if (y > 0) n |= from[y - 1];
+    else if (wrap_) n |= from[h_ - 1];
+    if (y + 1 < h_) n |= from[y + 1];
+    else if (wrap_) n |= from[0];
+    out[y] = n & free_[y];
+  }
+}
+
+int BoardSearch::scalarBfs(Point from, int target) {
+  std::fill(dist_.begin(), dist_.end(), -1);
+  const int start = from.y * w_ + from.x;
+  int head = 0, tail = 0, area = passable(start) ? 1 : 0;
+  dist_[start] = 0;
+  queue_[tail++] = start;
+  if (target == start) return passable(start) ? 0 : -1;
+
+  while (head < tail) {
+    const int i = queue_[head++];
+    const int x = i % w_, y = i / w_;
+    for (Direction d : {Direction::kUp, Direction::kDown, Direction::kLeft,
+                        Direction::kRight}) {
+      int nx = x + rules::deltaX(d), ny = y + rules::deltaY(d);
+      if (wrap_) {
+        nx = rules::wrapCoord(nx, w_, 0);
+        ny = rules::wrapCoord(ny, h_, 0);
+      } else if (nx < 0 || nx >= w_ || ny < 0 || ny >= h_) {
+        continue;
+      }
+      const int j = ny * w_ + nx;
+      if (dist_[j] >= 0 || !passable(j)) continue;
+      dist_[j] = dist_[i] + 1;
+      if (j == target) return dist_[j];
+      ++area;
+      queue_[tail++] = j;
+    }
+  }
+  return target >= 0 ? -1 : area;
+}
+
+int BoardSearch::reachableArea(const Engine& e, Point from, bool tail_free) {
+  if (!prepare(e, from, tail_free)) return 0;
+  if (!bitboard()) return scalarBfs(from, -1);
+
+  loadRows();
+  std::fill(reach_.begin(), reach_.end(), 0);
+  const std::uint64_t bit = std::uint64_t{1} << from.x;
+  reach_[from.y] = bit;
+  // Соседи from засевают заливку, даже если сама from занята
+  neighbors(reach_, frontier_);
+  for (int y = 0; y < h_; ++y) reach_[y] = frontier_[y];
+  reach_[from.y] |= bit & free_[from.y];
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    auto relax = [&](int y) {
+      std::uint64_t in = reach_[y];
+      if (y > 0) in |= reach_[y - 1];
+      else if (wrap_) in |= reach_[h_ - 1];
+      if (y + 1 < h_) in |= reach_[y + 1];
+      else if (wrap_) in |= reach_[0];
+      const std::uint64_t r = fillRow(in & free_[y], free_[y]);
+      if (r != reach_[y]) {
+        reach_[y] = r;
+        changed = true;
+      }
+    };
+    for (int y = 0; y < h_; ++y) relax(y);
+    for (int y = h_ - 1; y >= 0; --y) relax(y);
+  }
+
+  int area = 0;
+  for (int y = 0; y < h_; ++y) area += std::popcount(reach_[y]);
+  return area;
+}
+
+int BoardSearch::bitboardBfs(Point from, int target) {
+  loadRows();
+  std::fill(dist_.begin(), dist_.end(), -1);
+  std::fill(frontier_.begin(), frontier_.end(), 0);
+  std::fill(reach_.begin(), reach_.end(), 0);
+  const int start = from.y * w_ + from.x;
+  dist_[start] = 0;
+  if (target == start) return passable(start) ? 0 : -1;
+  frontier_[from.y] = reach_[from.y] = std::uint64_t{1} << from.x;
+
+  // Уровень за уровнем: новый фронт — проходимые соседи старого, еще не
+  // достигнутые; расстояния пишутся только для его бит
+  for (int d = 1;; ++d) {
+    neighbors(frontier_, next_);
+    bool any = false;
+    for (int y = 0; y < h_; ++y) {
+      std::uint64_t n = next_[y] & ~reach_[y];
+      frontier_[y] = n;
+      reach_[y] |= n;
+      any |= n != 0;
+      for (; n; n &= n - 1) dist_[y * w_ + std::countr_zero(n)] = d;
+    }
+    if (!any) return -1;
+    if (target >= 0 && dist_[target] >= 0) return d;
+  }
+}
+
+std::span<const int> BoardSearch::distanceField(const Engine& e, Point from,
+                                                bool tail_free) {
+  if (!prepare(e, from, tail_free))
+    std::fill(dist_.begin(), dist_.end(), -1);
+  else if (bitboard())
+    (void)bitboardBfs(from, -1);
+  else
+    (void)scalarBfs(from, -1);
+  return dist_;
+}
+
+int BoardSearch::distance(const Engine& e, Point from, Point to,
+                          bool tail_free) {
+  if (!prepare(e, from, tail_free)) return -1;
+  if (to.x < 0 || to.x >= w_ || to.y < 0 || to.y >= h_) return -1;
+  const int target = to.y * w_ + to.x;
+  return bitboard() ? bitboardBfs(from, target) : scalarBfs(from, target);
+}
+
+}  // namespace s21::snake
@@ -0,0 +1,114 @@
+/**
+ * @file search.h
+ * @brief Заливка и поле расстояний BFS по полю Snake для ботов
+ * @author BrickGame Team
+ * @version 2.0
+ * @date 2024
+ *
+ * @details
+ * BoardSearch отвечает на вопросы «сколько свободных клеток доступно из
+ * клетки» и «за сколько шагов дойти до каждой клетки», читая битовую
+ * карту змейки движка (Engine::occupancy()). Проходимы клетки вне змейки
+ * и, по желанию, хвост: без роста он освобождается на следующем тике.
+ *
+ * Для полей шириной до 64 клеток строка поля — одно слово uint64_t, и
+ * поиск идет по целым строкам: заливка растекается вдоль строки
+ * заполнением Когге — Стоуна (6 сдвигов на слово) и между строками
+ * прямым и обратным проходом, BFS раскрывает фронт волны целиком за
+ * O(H) операций на уровень. Более широкие поля обходятся обычной
+ * очередью. Рабочие массивы живут в объекте и переиспользуются: после
+ * первого запроса для поля того же размера память не выделяется, так
+ * что одного BoardSearch на поток хватает на всю партию.
+ */
+
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "backend.h"
+
+namespace s21::snake {
+
+/**
+ * @class BoardSearch
+ * @brief Заливка и BFS по полю движка с переиспользуемой памятью
+ */
+class BoardSearch {
+ public:
+  /**
+   * @enum Mode
+   * @brief Реализация поиска
+   */
+  enum class Mode {
+    kAuto,   ///< Битовые строки, если поле не шире 64 клеток
+    kScalar  ///< Всегда очередь по клеткам (эталон для тестов)
+  };
+
+  /** @brief Наибольшая ширина поля для битовых строк */
+  static constexpr int kMaxBitboardWidth = 64;
+
+  /**
+   * @brief Конструктор
+   * @param mode Реализация поиска
+   */
+  explicit BoardSearch(Mode mode = Mode::kAuto) : mode_(mode) {}
+
+  /**
+   * @brief Число проходимых клеток, достижимых из from
+   * @details Сама from может быть занята (например, головой); она
+   *          учитывается, только если проходима.
+   * @param tail_free Считать хвост проходимым
+   * @return 0, если from вне поля
+   */
+  int reachableArea(const Engine& e, Point from, bool tail_free = true);
+
+  /**
+   * @brief Расстояния в шагах от from до каждой клетки
+   * @param tail_free Считать хвост проходимым
+   * @return width * height значений по индексу y * width + x; -1 —
+   *         клетка недостижима или непроходима, 0 — from. Действительно
+   *         до следующего запроса
+   */
+  std::span<const int> distanceField(const Engine& e, Point from,
+                                     bool tail_free = true);
+
+  /**
+   * @brief Длина кратчайшего пути от from до to
+   * @details Поиск останавливается, как только волна дошла до to.
+   * @param tail_free Считать хвост проходимым
+   * @return -1, если to недостижима или непроходима
+   */
+  int distance(const Engine& e, Point from, Point to, bool tail_free = true);
+
+ private:
+  Mode mode_;
+  int w_{0}, h_{0};             ///< Размер поля последнего запроса
+  bool wrap_{false};            ///< Поле-тор
+  std::uint64_t full_{0};       ///< Маска w_ младших бит
+  std::vector<std::uint64_t> free_;      ///< Проходимые клетки по строкам
+  std::vector<std::uint64_t> reach_;     ///< Достигнутые клетки по строкам
+  std::vector<std::uint64_t> frontier_;  ///< Фронт волны BFS по строкам
+  std::vector<std::uint64_t> next_;      ///< Следующий фронт BFS
+  std::vector<int> dist_;                ///< Поле расстояний
+  std::vector<int> queue_;               ///< Очередь скалярного BFS
+  const std::uint64_t* occ_{nullptr};    ///< Битовая карта змейки
+  int tail_{-1};                         ///< Проходимый хвост или -1
+
+  bool prepare(const Engine& e, Point from, bool tail_free);
+  bool bitboard() const {
+    return mode_ != Mode::kScalar && w_ <= kMaxBitboardWidth;
+  }
+  void loadRows();
+  std::uint64_t spreadRow(std::uint64_t r) const;
+  std::uint64_t fillRow(std::uint64_t s, std::uint64_t f) const;
+  void neighbors(const std::vector<std::uint64_t>& from,
+                 std::vector<std::uint64_t>& out) const;
+  bool passable(int i) const {
+    return i == tail_ || !((occ_[i >> 6] >> (i & 63)) & 1u);
+  }
+  int scalarBfs(Point from, int target);
+  int bitboardBfs(Point from, int target);
+};
+
+}  // namespace s21::snake
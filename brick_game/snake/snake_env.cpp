@@ -0,0 +1,133 @@
+#include "snake_env.h"
+
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <span>
+#include <vector>
+
+#include "batch.h"
+#include "observation.h"
+
+using s21::snake::Direction;
+using s21::snake::SnakeBatch;
+using s21::snake::State;
+
+struct snake_env {
+  snake_env(int count, int width, int height, bool wrap)
+      : batch(count, width, height, wrap),
+        actions(count, Direction::kRight),
+        prev_score(count, 0),
+        scores(count, 0),
+        next_seed(count) {
+    for (int g = 0; g < count; ++g) next_seed[g] = 1u + g;
+  }
+
+  SnakeBatch batch;
+  std::vector<Direction> actions;
+  std::vector<int> prev_score;         ///< Счет до шага
+  std::vector<std::int32_t> scores;    ///< Счет после шага (до сброса)
+  std::vector<std::uint32_t> next_seed;  ///< Seed следующего эпизода
+
+  std::size_t obsSize() const {
+    return s21::snake::observationSize(batch.width(), batch.height());
+  }
+
+  void restart(int g) {
+    batch.reset(g, next_seed[g]);
+    next_seed[g] += static_cast<std::uint32_t>(batch.size());
+    prev_score[g] = 0;
+  }
+};
+
+namespace {
+
+// Наблюдения всех партий считаются в int: count * C * H * W <= INT_MAX,
+// тогда obs_size и count * obs_size не переполняются ни в int, ни в size_t
+bool obsFitInt(int count, int width, int height) {
+  if (count < 0 || width <= 0 || height <= 0) return false;
+  const std::uint64_t limit = std::numeric_limits<int>::max();
+  const std::uint64_t cells = static_cast<std::uint64_t>(width) * height;
+  if (cells > limit / s21::snake::kObsPlanes) return false;
+  const std::uint64_t per_game = cells * s21::snake::kObsPlanes;
+  return count == 0 || per_game <= limit / static_cast<std::uint64_t>(count);
+}
+
+}  // namespace
+
+snake_env* snake_env_create(int count, int width, int height, int wrap) {
+  if (!obsFitInt(count, width, height)) return nullptr;
+  try {
+    return new snake_env(count, width, height, wrap != 0);
+  } catch (...) {
+    // std::invalid_argument от SnakeBatch или std::bad_alloc
+    return nullptr;
+  }
+}
+
+void snake_env_destroy(snake_env* env) { delete env; }
+
+int snake_env_count(const snake_env* env) {
+  return env ? env->batch.size() : -1;
+}
+
+int snake_env_obs_size(const snake_env* env) {
+  return env ? static_cast<int>(env->obsSize()) : -1;
+}
+
+int snake_env_reset(snake_env* env, const uint32_t* seeds, uint8_t* obs) {
+  if (!env || !seeds) return -1;
+  const int n = env->batch.size();
+  for (int g = 0; g < n; ++g) {
+    env->next_seed[g] = seeds[g];
+    env->restart(g);
+    env->scores[g] = 0;
+  }
+  if (obs)
+    (void)env->batch.observe(std::span(obs, env->obsSize() * n));
+  return 0;
+}
+
+int snake_env_step(snake_env* env, const int32_t* actions, uint8_t* obs,
+                   float* rewards, uint8_t* dones) {
+  if (!env || !actions || !dones) return -1;
+  SnakeBatch& b = env->batch;
+  const int n = b.size();
+  for (int g = 0; g < n; ++g) {
+    const std::int32_t a = actions[g];
+    env->actions[g] =
+        a >= 0 && a < 4 ? static_cast<Direction>(a) : b.direction(g);
+  }
+  b.step(env->actions);
+
+  for (int g = 0; g < n; ++g) {
+    const int score = b.score(g);
+    const bool dead = b.state(g) != State::kRunning;
+    // Поле заполнено: побеждать дальше некуда, эпизод тоже закончен
+    const bool done = dead || b.freeCells(g) == 0;
+    if (rewards)
+      rewards[g] = static_cast<float>(score - env->prev_score[g]) -
+                   (dead ? 1.0f : 0.0f);
+    dones[g] = done ? 1 : 0;
+    env->scores[g] = score;
+    if (done)
+      env->restart(g);
+    else
+      env->prev_score[g] = score;
+  }
+
+  if (obs) (void)b.observe(std::span(obs, env->obsSize() * n));
+  return 0;
+}
+
+int snake_env_observe_f32(const snake_env* env, float* obs) {
+  if (!env || !obs) return -1;
+  const std::size_t size = env->obsSize() * env->batch.size();
+  return env->batch.observe(std::span(obs, size)) ? 0 : -1;
+}
+
+int snake_env_scores(const snake_env* env, int32_t* scores) {
+  if (!env || !scores) return -1;
+  for (int g = 0; g < env->batch.size(); ++g) scores[g] = env->scores[g];
+  return 0;
+}
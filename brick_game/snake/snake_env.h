@@ -0,0 +1,108 @@
+/**
+ * @file snake_env.h
+ * @brief Плоский C ABI векторной среды Snake (lib/libsnake_env.so)
+ * @defgroup snake_env Векторная среда для обучения
+ * @{
+ *
+ * @details
+ * Одна среда — N партий SnakeBatch одного размера. Все массивы
+ * передает вызывающий: один вызов snake_env_step() продвигает все
+ * партии, пишет наблюдения (observation.h, uint8, N x C x H x W),
+ * награды и флаги завершения и сразу перезапускает закончившиеся
+ * партии. Поэтому наблюдение закончившейся партии — уже первый кадр
+ * следующей, как в векторных средах gym.
+ *
+ * Награда за шаг: +1 за съеденную еду, -1 за гибель, иначе 0.
+ * Действия: 0 — вверх, 1 — вниз, 2 — влево, 3 — вправо; любое другое
+ * значение сохраняет текущее направление.
+ *
+ * Партия g после snake_env_reset() с seed s_g при k-м автоматическом
+ * перезапуске получает seed s_g + k * N: при s_g = base + g все эпизоды
+ * всех партий идут с разными seed и воспроизводимы.
+ *
+ * Функции не бросают исключений; ошибки возвращаются кодом -1 или NULL.
+ * Одну среду нельзя вызывать из нескольких потоков одновременно.
+ */
+#ifndef BRICK_GAME_SNAKE_ENV_H
+#define BRICK_GAME_SNAKE_ENV_H
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define SNAKE_ENV_API __declspec(dllexport)
+#else
+#define SNAKE_ENV_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Непрозрачная среда. \ingroup snake_env */
+typedef struct snake_env snake_env;
+
+/**
+ * @brief Создать среду из count партий
+ * @param wrap 1 — поле-тор
+ * @return NULL при неверных размерах, если наблюдения всех партий
+ *         (count * obs_size элементов) не помещаются в int, или при
+ *         нехватке памяти
+ * \ingroup snake_env
+ */
+SNAKE_ENV_API snake_env* snake_env_create(int count, int width, int height,
+                                          int wrap);
+
+/** @brief Освободить среду (NULL допустим). \ingroup snake_env */
+SNAKE_ENV_API void snake_env_destroy(snake_env* env);
+
+/** @brief Число партий. \ingroup snake_env */
+SNAKE_ENV_API int snake_env_count(const snake_env* env);
+
+/** @brief Элементов в наблюдении партии (C * H * W). \ingroup snake_env */
+SNAKE_ENV_API int snake_env_obs_size(const snake_env* env);
+
+/**
+ * @brief Начать все партии заново
+ * @param seeds count семян
+ * @param obs Наблюдения (count * obs_size) или NULL
+ * @return 0 или -1
+ * \ingroup snake_env
+ */
+SNAKE_ENV_API int snake_env_reset(snake_env* env, const uint32_t* seeds,
+                                  uint8_t* obs);
+
+/**
+ * @brief Шаг всех партий с автоматическим перезапуском
+ * @param actions count действий
+ * @param obs Наблюдения после шага (count * obs_size) или NULL
+ * @param rewards count наград или NULL
+ * @param dones count флагов: 1 — партия закончилась на этом шаге
+ * @return 0 или -1
+ * \ingroup snake_env
+ */
+SNAKE_ENV_API int snake_env_step(snake_env* env, const int32_t* actions,
+                                 uint8_t* obs, float* rewards,
+                                 uint8_t* dones);
+
+/**
+ * @brief Наблюдения текущего состояния в float
+ * @param obs count * obs_size элементов
+ * @return 0 или -1
+ * \ingroup snake_env
+ */
+SNAKE_ENV_API int snake_env_observe_f32(const snake_env* env, float* obs);
+
+/**
+ * @brief Счет каждой партии; для закончившейся на последнем шаге —
+ *        итоговый счет эпизода
+ * @param scores count элементов
+ * @return 0 или -1
+ * \ingroup snake_env
+ */
+SNAKE_ENV_API int snake_env_scores(const snake_env* env, int32_t* scores);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICK_GAME_SNAKE_ENV_H
+/** @} */  // end of group snake_env
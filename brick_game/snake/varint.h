@@ -0,0 +1,66 @@
+/**
+ * @file varint.h
+ * @brief Беззнаковый LEB128 для двоичных форматов Snake
+ * @author BrickGame Team
+ * @version 2.0
+ * @date 2024
+ *
+ * @details
+ * Внутренний заголовок: общий код реплеев и снимков состояния движка.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace s21::snake::varint {
+
+/** @brief Дописать v в out (7 бит на байт, старший бит — продолжение) */
+inline void put(std::vector<std::uint8_t>& out, std::uint64_t v) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(v | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(v));
+}
+
+/**
+ * @class Reader
+ * @brief Последовательное чтение с проверкой границ
+ */
+class Reader {
+ public:
+  explicit Reader(std::span<const std::uint8_t> d) : d_(d) {}
+
+  bool byte(std::uint8_t& b) {
+    if (pos_ >= d_.size()) return false;
+    b = d_[pos_++];
+    return true;
+  }
+
+  bool value(std::uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      std::uint8_t b;
+      if (!byte(b)) return false;
+      v |= std::uint64_t{b & 0x7Fu} << shift;
+      if (!(b & 0x80)) return true;
+    }
+    return false;
+  }
+
+  /** @brief Прочитать значение не больше max */
+  bool value(std::uint64_t& v, std::uint64_t max) {
+    return value(v) && v <= max;
+  }
+
+  bool atEnd() const { return pos_ == d_.size(); }
+
+ private:
+  std::span<const std::uint8_t> d_;
+  std::size_t pos_{0};
+};
+
+}  // namespace s21::snake::varint
@@ -14,7 +14,7 @@ static void fsm_sigact(signals sig, tetris_t* g) {
       }
       break;
     case SPAWN: {
-      int rc = bg_spawn(&g->board, &g->cur, &g->next);
+      int rc = bg_spawn(&g->board, &g->cur, &g->next, &g->rng);
       if (rc == 1) {
         g->state = GAMEOVER;
       } else {
@@ -55,7 +55,7 @@ static void fsm_sigact(signals sig, tetris_t* g) {
       break;
     case GAMEOVER:
       if (sig == ENTER_BTN) {
-        bg_init(&g->board, &g->stats, &g->cur, &g->next);
+        bg_init(&g->board, &g->stats, &g->cur, &g->next, &g->rng);
         g->state = SPAWN;
       } else if (sig == ESCAPE_BTN) {
         g->state = EXIT_STATE;
@@ -70,7 +70,7 @@ static void fsm_sigact(signals sig, tetris_t* g) {
 }
 
 void tetris_init(tetris_t* g) {
-  bg_init(&g->board, &g->stats, &g->cur, &g->next);
+  bg_init(&g->board, &g->stats, &g->cur, &g->next, &g->rng);
   g->state = START;
 }
 
@@ -1,8 +1,14 @@
-#include <stdlib.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <time.h>
 
+#include "../../common/pcg32.h"
 #include "include/tetris_backend.h"
 
+// Поток PCG для партий, засеянных временем: партии, начатые в одну
+// секунду, все равно получают разные последовательности
+static atomic_uint_fast64_t g_next_stream;
+
 static void board_clear(board_t* b) {
   for (int i = 0; i < TETRIS_ROWS; ++i) {
     for (int j = 0; j < TETRIS_COLS; ++j) {
@@ -19,8 +25,13 @@ static void stats_reset(game_stats_t* s) {
   s->speed = 1;
 }
 
-static tetromino_type random_piece(void) {
-  return (tetromino_type)(rand() % 7);
+static tetromino_type random_piece(piece_rng_t* rng) {
+  return (tetromino_type)pcg32_bounded(&rng->pcg, 7);
+}
+
+void bg_seed(piece_rng_t* rng, uint64_t seed, uint64_t stream) {
+  pcg32_seed(&rng->pcg, seed, stream);
+  rng->seeded = true;
 }
 
 static void set_spawn_position(tetromino_t* t) {
@@ -30,12 +41,13 @@ static void set_spawn_position(tetromino_t* t) {
 }
 
 void bg_init(board_t* board, game_stats_t* stats, tetromino_t* current,
-             tetromino_t* next) {
-  srand((unsigned)time(NULL));
+             tetromino_t* next, piece_rng_t* rng) {
+  if (!rng->seeded)
+    bg_seed(rng, (uint64_t)time(NULL), atomic_fetch_add(&g_next_stream, 1));
   board_clear(board);
   stats_reset(stats);
 
-  next->type = random_piece();
+  next->type = random_piece(rng);
   set_spawn_position(next);
 
   *current = *next;
@@ -208,7 +220,8 @@ bool bg_tick(board_t* board, tetromino_t* current, game_stats_t* stats) {
   return falling;
 }
 
-int bg_spawn(board_t* board, tetromino_t* current, tetromino_t* next) {
+int bg_spawn(board_t* board, tetromino_t* current, tetromino_t* next,
+             piece_rng_t* rng) {
   int rc = 0;
 
   *current = *next;
@@ -217,7 +230,7 @@ int bg_spawn(board_t* board, tetromino_t* current, tetromino_t* next) {
   if (bg_collides(board, current, 0, 0)) {
     rc = 1;
   } else {
-    next->type = random_piece();
+    next->type = random_piece(rng);
     set_spawn_position(next);
   }
 
@@ -62,9 +62,13 @@ static signals map_event_to_signal(Event e) {
 
 Engine::Engine(Config cfg) : p_(new Impl{}) {
   p_->cfg = cfg;
+  // seed 0 — фигуры от текущего времени
+  if (cfg.seed != 0) bg_seed(&p_->g.rng, cfg.seed, 0);
   tetris_init(&p_->g);
 }
 
+Engine::~Engine() { delete p_; }
+
 State Engine::state() const { return map_state(tetris_state(&p_->g)); }
 
 void Engine::dispatch(Event e) {
@@ -78,10 +82,16 @@ void Engine::dispatch(Event e) {
 
 Snapshot Engine::snapshot() const {
   Snapshot s{};
+  snapshot(s);
+  return s;
+}
+
+void Engine::snapshot(Snapshot& s) const {
   s.state = state();
   s.width = TETRIS_COLS;
   s.height = TETRIS_ROWS;
 
+  // Поле фиксированного размера: resize() выделяет память только раз
   s.grid.resize(s.width * s.height, Cell::kEmpty);
   uint8_t raw[TETRIS_ROWS][TETRIS_COLS];
   tetris_export(&p_->g, raw);
@@ -103,6 +113,7 @@ Snapshot Engine::snapshot() const {
   s.current.rotation = static_cast<int>(p_->g.cur.rotation);
   s.current.visible = (p_->g.state == SPAWN || p_->g.state == FALL);
 
+  s.ghost.x = s.ghost.y = 0;
   s.ghost.visible = s.current.visible;
   if (s.ghost.visible) {
     s.ghost.x = s.current.x;
@@ -133,8 +144,6 @@ Snapshot Engine::snapshot() const {
     }
     s.ghost.y = max_y;
   }
-
-  return s;
 }
 
 }  // namespace s21::tetris
\ No newline at end of file
@@ -72,10 +72,20 @@ struct Snapshot {
 class Engine {
  public:
   explicit Engine(Config cfg = {});
+  ~Engine();
+  Engine(const Engine&) = delete;
+  Engine& operator=(const Engine&) = delete;
+
   State state() const;
   void dispatch(Event e);
   Snapshot snapshot() const;
 
+  /**
+   * @brief Заполнить снимок, переиспользуя его память
+   * @param out Снимок; после первого вызова больше не выделяет память
+   */
+  void snapshot(Snapshot& out) const;
+
  private:
   struct Impl;
   Impl* p_;
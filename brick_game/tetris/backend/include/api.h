@@ -20,6 +20,7 @@ typedef struct {
   tetromino_t next;
   game_stats_t stats;
   game_state state;
+  piece_rng_t rng; /**< Генератор фигур; bg_seed() до tetris_init(). */
 } tetris_t;
 
 /** @brief Полная инициализация игры и перевод в состояние START. \ingroup api
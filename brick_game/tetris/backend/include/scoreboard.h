@@ -26,12 +26,21 @@ typedef struct {
  * .tetris_scores.tsv). \ingroup scores */
 int sc_default_path(char *buf, size_t buflen);
 
-/** @brief Загрузка таблицы из TSV. \ingroup scores */
+/** @brief Загрузка таблицы из TSV рабочим потоком persist.h: чтение
+ * видит все записи, поставленные раньше, и ждет только себя.
+ * Отсутствующий файл — пустая таблица. \ingroup scores */
 int sc_load(scoreboard_t *tb, const char *path);
 
-/** @brief Сохранение таблицы в TSV. \ingroup scores */
+/** @brief Сохранение таблицы в TSV в фоне (persist.h): не блокирует,
+ * файл подменяется атомарно. \ingroup scores */
 int sc_save(const scoreboard_t *tb, const char *path);
 
+/** @brief Добавить результат в таблицу файла, не дожидаясь диска:
+ * чтение, вставка и запись выполняются рабочим потоком persist.h.
+ * Таблица, которую не удалось прочитать, не перезаписывается.
+ * \ingroup scores */
+int sc_record(const char *name, int score, const char *path);
+
 /**
  * @brief Добавить результат и отсортировать по убыванию.
  * Если таблица полна и результат ниже последнего — игнорируется.
@@ -22,19 +22,31 @@ extern const uint16_t TETROMINO_SHAPES[7][4];
  */
 bool shape_has_block(tetromino_type type, rotation_t rot, int r, int c);
 
+/**
+ * @brief Задать семя и поток генератора фигур партии (PCG32).
+ * bg_init() засевает генератор текущим временем и собственным потоком,
+ * если bg_seed() не вызывалась; после вызова последовательность фигур
+ * воспроизводима, разные stream независимы.
+ * @ingroup core
+ */
+void bg_seed(piece_rng_t* rng, uint64_t seed, uint64_t stream);
+
 /**
  * @brief Инициализация поля/статистики и генерация текущей/следующей фигуры.
+ * @param rng Генератор фигур партии
  * @ingroup core
  */
 void bg_init(board_t* board, game_stats_t* stats, tetromino_t* current,
-             tetromino_t* next);
+             tetromino_t* next, piece_rng_t* rng);
 
 /**
  * @brief Появление новой фигуры: current <- next, next = случайная.
+ * @param rng Генератор фигур партии
  * @return 1 если коллизия на спауне (GAMEOVER), иначе 0.
  * @ingroup core
  */
-int bg_spawn(board_t* board, tetromino_t* current, tetromino_t* next);
+int bg_spawn(board_t* board, tetromino_t* current, tetromino_t* next,
+             piece_rng_t* rng);
 
 /**
  * @brief Попытка сдвига текущей фигуры.
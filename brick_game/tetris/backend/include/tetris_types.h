@@ -9,6 +9,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "../../../common/pcg32.h"
+
 /** Высота игрового поля в клетках. */
 #define TETRIS_ROWS 20
 /** Ширина игрового поля в клетках. */
@@ -56,6 +58,12 @@ typedef struct {
   int speed;         /**< Произвольная метрика скорости (для HUD). */
 } game_stats_t;
 
+/** @brief Генератор фигур одной партии. */
+typedef struct {
+  pcg32_t pcg; /**< Состояние PCG32. */
+  bool seeded; /**< Засеян bg_seed(); иначе bg_init() засеет временем. */
+} piece_rng_t;
+
 /** @brief Состояния конечного автомата. */
 typedef enum {
   START,
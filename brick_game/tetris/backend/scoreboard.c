@@ -1,9 +1,11 @@
 #include <errno.h>
 #include <limits.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "../../common/persist.h"
 #include "include/scoreboard.h"
 
 #ifndef PATH_MAX
@@ -42,6 +44,14 @@ int sc_default_path(char *buf, size_t buflen) {
   return rc;
 }
 
+// Копия имени с обрезкой до TETRIS_NAME_MAX; всегда завершается нулем
+static void sc_copy_name(char *dst, const char *src) {
+  size_t n = strlen(src);
+  if (n > TETRIS_NAME_MAX) n = TETRIS_NAME_MAX;
+  memcpy(dst, src, n);
+  dst[n] = '\0';
+}
+
 static int sc_resolve_path(const char *in, char *out, size_t out_len) {
   int rc = 0;
   if (in && *in) {
@@ -58,10 +68,54 @@ static int sc_resolve_path(const char *in, char *out, size_t out_len) {
   return rc;
 }
 
+// Строки "имя<TAB>счет"; неразборчивые строки пропускаются
+static void sc_parse(scoreboard_t *tb, const char *data, size_t len) {
+  const char *end = data + len;
+  tb->count = 0;
+  while (data < end && tb->count < TETRIS_MAX_SCORES) {
+    const char *nl = memchr(data, '\n', (size_t)(end - data));
+    size_t n = (size_t)((nl ? nl : end) - data);
+    char line[256];
+    if (n >= sizeof line) n = sizeof line - 1;
+    memcpy(line, data, n);
+    line[n] = '\0';
+    data = nl ? nl + 1 : end;
+
+    sc_trim_newline(line);
+    char *tab = strchr(line, '\t');
+    if (!tab) continue;
+    *tab = '\0';
+    long v = strtol(tab + 1, NULL, 10);
+    if (v < 0 || v > INT_MAX) continue;
+
+    score_entry_t *e = &tb->list[tb->count++];
+    sc_copy_name(e->name, line);
+    e->score = (int)v;
+  }
+}
+
+/** @brief Ожидание чтения таблицы рабочим потоком persist */
+typedef struct {
+  pthread_mutex_t mu;
+  pthread_cond_t cv;
+  scoreboard_t *tb;
+  int rc;
+  int done;
+} sc_load_req;
+
+static void sc_on_loaded(void *ctx, const char *data, size_t len, int found) {
+  sc_load_req *req = ctx;
+  if (found > 0) sc_parse(req->tb, data, len);
+  pthread_mutex_lock(&req->mu);
+  req->rc = found < 0 ? -1 : 0;
+  req->done = 1;
+  pthread_cond_signal(&req->cv);
+  pthread_mutex_unlock(&req->mu);
+}
+
 int sc_load(scoreboard_t *tb, const char *path) {
   int rc = 0;
   char real_path[PATH_MAX];
-  FILE *f = NULL;
 
   if (!tb) {
     errno = EINVAL;
@@ -69,36 +123,23 @@ int sc_load(scoreboard_t *tb, const char *path) {
   } else if (sc_resolve_path(path, real_path, sizeof real_path) != 0) {
     rc = -1;
   } else {
+    // Чтение идет в очереди persist после поставленных раньше записей
+    // этого пути; ждем только его, а не всю очередь
+    sc_load_req req = {.mu = PTHREAD_MUTEX_INITIALIZER,
+                       .cv = PTHREAD_COND_INITIALIZER,
+                       .tb = tb};
     tb->count = 0;
-    f = fopen(real_path, "r");
-    if (!f) {
-      if (errno == ENOENT) {
-        rc = 0;
-      } else {
-        rc = -1;
-      }
+    if (ps_load_async(real_path, sc_on_loaded, &req) != 0) {
+      rc = -1;
     } else {
-      char line[256];
-      while (fgets(line, sizeof line, f) && tb->count < TETRIS_MAX_SCORES) {
-        sc_trim_newline(line);
-        char *tab = strchr(line, '\t');
-        if (!tab) continue;
-        *tab = '\0';
-        const char *name = line;
-        const char *score_str = tab + 1;
-        long v = strtol(score_str, NULL, 10);
-        if (v < 0 || v > INT_MAX) continue;
-
-        score_entry_t *e = &tb->list[tb->count++];
-        strncpy(e->name, name, TETRIS_NAME_MAX);
-        e->name[TETRIS_NAME_MAX] = '\0';
-        e->score = (int)v;
-      }
+      pthread_mutex_lock(&req.mu);
+      while (!req.done) pthread_cond_wait(&req.cv, &req.mu);
+      rc = req.rc;
+      pthread_mutex_unlock(&req.mu);
+      if (rc != 0) errno = EIO;
     }
-  }
-
-  if (f) {
-    if (fclose(f) != 0 && rc == 0) rc = -1;
+    pthread_cond_destroy(&req.cv);
+    pthread_mutex_destroy(&req.mu);
   }
   return rc;
 }
@@ -132,12 +173,7 @@ int sc_submit(scoreboard_t *tb, const char *name, int score) {
     rc = -1;
   } else {
     score_entry_t e;
-    strncpy(e.name, name, TETRIS_NAME_MAX);
-    e.name[TETRIS_NAME_MAX] = '\0';
-    if (e.name[0] == '\0') {
-      strncpy(e.name, "Player", TETRIS_NAME_MAX);
-      e.name[TETRIS_NAME_MAX] = '\0';
-    }
+    sc_copy_name(e.name, name[0] ? name : "Player");
     if (score < 0) score = 0;
     e.score = score;
     sc_insert_sorted(tb, &e);
@@ -145,33 +181,84 @@ int sc_submit(scoreboard_t *tb, const char *name, int score) {
   return rc;
 }
 
+// Строка: имя, табуляция, счет до 10 цифр, перевод строки
+#define SC_TEXT_MAX (TETRIS_MAX_SCORES * (TETRIS_NAME_MAX + 13))
+
+static int sc_format(const scoreboard_t *tb, char *buf, size_t *len) {
+  int rc = 0;
+  *len = 0;
+  for (int i = 0; i < tb->count && rc == 0; ++i) {
+    int n = snprintf(buf + *len, SC_TEXT_MAX - *len, "%s\t%d\n",
+                     tb->list[i].name, tb->list[i].score);
+    if (n < 0 || (size_t)n >= SC_TEXT_MAX - *len) {
+      errno = EOVERFLOW;
+      rc = -1;
+    } else {
+      *len += (size_t)n;
+    }
+  }
+  return rc;
+}
+
 int sc_save(const scoreboard_t *tb, const char *path) {
   int rc = 0;
   char real_path[PATH_MAX];
-  FILE *f = NULL;
+  char buf[SC_TEXT_MAX];
+  size_t len = 0;
 
-  if (!tb) {
+  if (!tb || tb->count < 0 || tb->count > TETRIS_MAX_SCORES) {
     errno = EINVAL;
     rc = -1;
   } else if (sc_resolve_path(path, real_path, sizeof real_path) != 0) {
     rc = -1;
   } else {
-    f = fopen(real_path, "w");
-    if (!f) {
-      rc = -1;
-    } else {
-      for (int i = 0; i < tb->count; ++i) {
-        if (fprintf(f, "%s\t%d\n", tb->list[i].name, tb->list[i].score) < 0) {
-          rc = -1;
-          break;
-        }
-      }
-      if (rc == 0 && fflush(f) != 0) rc = -1;
-    }
+    rc = sc_format(tb, buf, &len);
+    // Запись уходит в фоновый поток: экран Game Over не ждет диска
+    if (rc == 0) rc = ps_write_async(real_path, buf, len);
+  }
+  return rc;
+}
+
+/** @brief Результат для sc_record(); освобождается рабочим потоком */
+typedef struct {
+  score_entry_t entry;
+  char path[PATH_MAX];
+} sc_record_req;
+
+static void sc_on_record_loaded(void *ctx, const char *data, size_t len,
+                                int found) {
+  sc_record_req *req = ctx;
+  // При ошибке чтения таблица не перезаписывается одним результатом
+  if (found >= 0) {
+    scoreboard_t tb = {.count = 0};
+    char buf[SC_TEXT_MAX];
+    size_t out_len = 0;
+    if (found > 0) sc_parse(&tb, data, len);
+    sc_insert_sorted(&tb, &req->entry);
+    // Запись прямо здесь, в рабочем потоке: чтение, поставленное после
+    // sc_record(), должно увидеть новую таблицу
+    if (sc_format(&tb, buf, &out_len) == 0)
+      (void)ps_write_atomic(req->path, buf, out_len);
   }
+  free(req);
+}
 
-  if (f) {
-    if (fclose(f) != 0 && rc == 0) rc = -1;
+int sc_record(const char *name, int score, const char *path) {
+  int rc = 0;
+  sc_record_req *req = NULL;
+  if (!name) {
+    errno = EINVAL;
+    rc = -1;
+  } else if (!(req = malloc(sizeof *req))) {
+    rc = -1;
+  } else if (sc_resolve_path(path, req->path, sizeof req->path) != 0) {
+    rc = -1;
+  } else {
+    sc_copy_name(req->entry.name, name[0] ? name : "Player");
+    req->entry.score = score < 0 ? 0 : score;
+    rc = ps_load_async(req->path, sc_on_record_loaded, req);
+    if (rc == 0) req = NULL;
   }
+  free(req);
   return rc;
-}
\ No newline at end of file
+}
@@ -43,11 +43,7 @@ void game_loop(void) {
     }
 
     if (g.state == GAMEOVER && !saved_this_round) {
-      scoreboard_t tb;
-      if (sc_load(&tb, NULL) == 0) {
-        sc_submit(&tb, username, g.stats.score);
-        (void)sc_save(&tb, NULL);
-      }
+      (void)sc_record(username, g.stats.score, NULL);
       saved_this_round = true;
     }
     if (saved_this_round && g.state != GAMEOVER) {
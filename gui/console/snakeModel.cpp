@@ -24,9 +24,8 @@ void SnakeModel::tick() { engine_.dispatch(s21::snake::Event::kTick); }
 
 void SnakeModel::quit() { engine_.dispatch(s21::snake::Event::kQuit); }
 
-const s21::snake::Snapshot& SnakeModel::getSnapshot() const {
-  current_snapshot_ = engine_.snapshot();
-  return current_snapshot_;
+s21::snake::SnapshotView SnakeModel::getSnapshot() const {
+  return engine_.view();
 }
 
 bool SnakeModel::isRunning() const {
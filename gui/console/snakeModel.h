@@ -6,7 +6,6 @@
 class SnakeModel {
  private:
   s21::snake::Engine engine_;
-  mutable s21::snake::Snapshot current_snapshot_;
 
  public:
   SnakeModel();
@@ -21,7 +20,7 @@ class SnakeModel {
   void tick();
   void quit();
 
-  const s21::snake::Snapshot& getSnapshot() const;
+  s21::snake::SnapshotView getSnapshot() const;
   bool isRunning() const;
   bool isPaused() const;
   bool isGameOver() const;
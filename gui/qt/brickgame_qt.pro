@@ -18,6 +18,11 @@ INCLUDEPATH += . \
     ../../brick_game/tetris \
     ../../brick_game/tetris/backend/include
 
+# --- Фоновое сохранение рекордов (общее для Snake и Tetris) ---
+SOURCES += ../../brick_game/common/persist.c
+HEADERS += ../../brick_game/common/persist.h
+LIBS    += -lpthread
+
 # --- Главный файл приложения (твой общий main) ---
 SOURCES += \
     main.cpp
@@ -33,7 +38,8 @@ HEADERS += \
     snake/GameController.h \
     snake/SnakeWidget.h \
     snake/SidebarWidget.h \
-    ../../brick_game/snake/backend.h
+    ../../brick_game/snake/backend.h \
+    ../../brick_game/snake/ring_buffer.h
 
 # --- Tetris (Qt + C++ адаптер + C-ядро) ---
 SOURCES += \
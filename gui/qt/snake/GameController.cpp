@@ -19,8 +19,7 @@ void GameController::start() {
 }
 
 void GameController::onTick() {
-  auto s = model_.snapshot();
-  if (s.state == State::kRunning) {
+  if (model_.state() == State::kRunning) {
     model_.dispatch(Event::kTick);
     syncView();
     updateTimerFromModel();
@@ -77,14 +76,14 @@ void GameController::onKeyPressed(int key) {
 }
 
 void GameController::syncView() {
-  auto snap = model_.snapshot();
+  auto snap = model_.view();
   if (view_) view_->setSnapshot(snap);
   if (sidebar_) sidebar_->setSnapshot(snap);
   updateTimerFromModel();
 }
 
 void GameController::updateTimerFromModel() {
-  int ms = model_.snapshot().speed_ms;
+  int ms = model_.view().speed_ms;
   if (ms < 10) ms = 10;
   timer_.setInterval(ms);
 }
\ No newline at end of file
@@ -46,7 +46,7 @@ SidebarWidget::SidebarWidget(QWidget* parent) : QWidget(parent) {
   layout->addStretch();
 }
 
-void SidebarWidget::setSnapshot(const s21::snake::Snapshot& snap) {
+void SidebarWidget::setSnapshot(const s21::snake::SnapshotView& snap) {
   snap_ = snap;
   update();
 }
@@ -9,7 +9,7 @@ class SidebarWidget : public QWidget {
  public:
   explicit SidebarWidget(QWidget* parent = nullptr);
 
-  void setSnapshot(const s21::snake::Snapshot& snap);
+  void setSnapshot(const s21::snake::SnapshotView& snap);
 
   QPushButton* startButton() const { return start_btn_; }
   QPushButton* pauseButton() const { return pause_btn_; }
@@ -20,7 +20,7 @@ class SidebarWidget : public QWidget {
   void paintEvent(QPaintEvent*) override;
 
  private:
-  s21::snake::Snapshot snap_;
+  s21::snake::SnapshotView snap_;
   QPushButton* start_btn_;
   QPushButton* pause_btn_;
   QPushButton* reset_btn_;
@@ -9,7 +9,7 @@ SnakeWidget::SnakeWidget(QWidget* parent) : QWidget(parent) {
   setMinimumSize(400, 400);
 }
 
-void SnakeWidget::setSnapshot(const s21::snake::Snapshot& snap) {
+void SnakeWidget::setSnapshot(const s21::snake::SnapshotView& snap) {
   snap_ = snap;
   update();
 }
@@ -35,9 +35,10 @@ class SnakeWidget : public QWidget {
 
   /**
    * @brief Установить снимок состояния игры
-   * @param snap Снимок состояния для отображения
+   * @param snap Представление состояния; контроллер обновляет его после
+   *             каждого dispatch(), поэтому оно действительно при отрисовке
    */
-  void setSnapshot(const s21::snake::Snapshot& snap);
+  void setSnapshot(const s21::snake::SnapshotView& snap);
 
   /**
    * @brief Получить рекомендуемый размер виджета
@@ -53,7 +54,7 @@ class SnakeWidget : public QWidget {
   void paintEvent(QPaintEvent*) override;
 
  private:
-  s21::snake::Snapshot snap_;              ///< Текущий снимок состояния игры
+  s21::snake::SnapshotView snap_;          ///< Текущий снимок состояния игры
   int cell_ = 20;                          ///< Размер клетки в пикселях
   int pad_ = 12;                           ///< Отступы от краев
   QColor bgTop_ = QColor(18, 18, 28);     ///< Цвет верхней части фона
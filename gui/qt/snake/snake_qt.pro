@@ -28,4 +28,4 @@ INCLUDEPATH += \
     $$PWD/../../../brick_game/snake
 
 # линкуем статическую библиотеку змейки
-LIBS += -L$$PWD/../../../lib -lsnake
\ No newline at end of file
+LIBS += -L$$PWD/../../../lib -lsnake -lpthread
\ No newline at end of file
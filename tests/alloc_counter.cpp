@@ -0,0 +1,121 @@
+#include "alloc_counter.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Константная инициализация: обращение из malloc не выделяет память
+thread_local bool t_armed = false;
+thread_local long t_count = 0;
+
+inline void note() {
+  if (t_armed) ++t_count;
+}
+
+}  // namespace
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(std::size_t);
+void* __libc_calloc(std::size_t, std::size_t);
+void* __libc_realloc(void*, std::size_t);
+
+void* malloc(std::size_t n) noexcept {
+  note();
+  return __libc_malloc(n);
+}
+
+void* calloc(std::size_t n, std::size_t size) noexcept {
+  note();
+  return __libc_calloc(n, size);
+}
+
+void* realloc(void* p, std::size_t n) noexcept {
+  note();
+  return __libc_realloc(p, n);
+}
+}
+
+namespace {
+inline void* rawAlloc(std::size_t n) { return __libc_malloc(n ? n : 1); }
+}  // namespace
+#else
+namespace {
+inline void* rawAlloc(std::size_t n) { return std::malloc(n ? n : 1); }
+}  // namespace
+#endif
+
+namespace {
+
+void* countedNew(std::size_t n) {
+  note();
+  if (void* p = rawAlloc(n)) return p;
+  throw std::bad_alloc();
+}
+
+void* countedNew(std::size_t n, std::align_val_t al) {
+  note();
+  const auto a = static_cast<std::size_t>(al);
+  // aligned_alloc требует размер, кратный выравниванию
+  const std::size_t size = n ? (n + a - 1) / a * a : a;
+  if (void* p = std::aligned_alloc(a, size)) return p;
+  throw std::bad_alloc();
+}
+
+}  // namespace
+
+void* operator new(std::size_t n) { return countedNew(n); }
+void* operator new[](std::size_t n) { return countedNew(n); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+  try {
+    return countedNew(n);
+  } catch (...) {
+    return nullptr;
+  }
+}
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept {
+  return operator new(n, std::nothrow);
+}
+void* operator new(std::size_t n, std::align_val_t al) {
+  return countedNew(n, al);
+}
+void* operator new[](std::size_t n, std::align_val_t al) {
+  return countedNew(n, al);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+
+namespace alloc_counter {
+
+AllocScope::AllocScope() : start_(t_count), outer_(!t_armed) {
+  t_armed = true;
+}
+
+AllocScope::~AllocScope() {
+  if (outer_) t_armed = false;
+}
+
+long AllocScope::count() const { return t_count - start_; }
+
+bool countsMalloc() {
+#if defined(__GLIBC__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace alloc_counter
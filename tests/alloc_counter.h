@@ -0,0 +1,38 @@
+/**
+ * @file alloc_counter.h
+ * @brief Счетчик выделений памяти для тестов «ноль аллокаций»
+ *
+ * @details
+ * alloc_counter.cpp подменяет глобальные operator new/new[] (все
+ * варианты) и, на glibc, malloc/calloc/realloc. Считаются только
+ * вызовы из потока, в котором жив AllocScope, поэтому фоновые потоки
+ * (persist.h, gtest) не мешают измерению.
+ */
+
+#pragma once
+
+namespace alloc_counter {
+
+/**
+ * @class AllocScope
+ * @brief Считает выделения памяти текущего потока за время жизни
+ */
+class AllocScope {
+ public:
+  AllocScope();
+  ~AllocScope();
+  AllocScope(const AllocScope&) = delete;
+  AllocScope& operator=(const AllocScope&) = delete;
+
+  /** @brief Число выделений с момента создания */
+  long count() const;
+
+ private:
+  long start_;
+  bool outer_;  ///< Первый AllocScope потока включает подсчет
+};
+
+/** @brief Перехватываются ли malloc/calloc/realloc на этой платформе */
+bool countsMalloc();
+
+}  // namespace alloc_counter
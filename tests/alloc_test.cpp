@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "alloc_counter.h"
+#include "brick_game/snake/backend.h"
+#include "brick_game/snake/rules.h"
+#include "brick_game/tetris/backend/engine.h"
+
+using alloc_counter::AllocScope;
+
+TEST(AllocCounter, SeesNewAndMalloc) {
+  // volatile не дает компилятору убрать пары new/delete и malloc/free
+  void* volatile sink = nullptr;
+  AllocScope scope;
+  auto* v = new std::vector<int>(16);
+  sink = v;
+  delete v;
+  EXPECT_GE(scope.count(), 2);
+  if (alloc_counter::countsMalloc()) {
+    const long before = scope.count();
+    sink = std::malloc(8);
+    std::free(sink);
+    EXPECT_EQ(scope.count(), before + 1);
+  }
+}
+
+TEST(AllocFree, SnakeTicks) {
+  namespace sn = s21::snake;
+  // Хранилище по умолчанию: рекорд пишется в файл через persist.h
+  const std::string path = ::testing::TempDir() + "alloc_test_best.txt";
+  std::remove(path.c_str());
+  {
+    sn::Engine e{sn::Config{20, 20, 7, false, path}};
+    sn::Snapshot snap;
+    // Первый снимок заводит буферы; дальше память переиспользуется
+    e.dispatch(sn::Event::kStart);
+    e.snapshot(snap);
+    const int best_before = snap.best;
+
+    unsigned r = 12345;
+    int games = 0;
+    AllocScope scope;
+    for (int t = 0; t < 100000; ++t) {
+      if (e.state() != sn::State::kRunning) {
+        e.dispatch(sn::Event::kStart);
+        ++games;
+      }
+      r = r * 1103515245u + 12345u;
+      if ((r >> 28) < 4) {
+        const auto d = static_cast<sn::Direction>((r >> 16) % 4);
+        e.dispatch(sn::rules::moveEvent(d));
+      }
+      e.dispatch(sn::Event::kTick);
+      if ((t & 63) == 0) {
+        e.snapshot(snap);
+        (void)e.view();
+      }
+    }
+    EXPECT_EQ(scope.count(), 0);
+    EXPECT_GT(games, 0);
+    // Новые рекорды действительно сохранялись
+    EXPECT_GT(e.view().best, best_before);
+  }
+  std::ifstream in(path);
+  int saved = 0;
+  in >> saved;
+  EXPECT_GT(saved, 0);
+  std::remove(path.c_str());
+}
+
+TEST(AllocFree, TetrisDispatch) {
+  namespace tt = s21::tetris;
+  tt::Engine e;
+  tt::Snapshot snap;
+  e.dispatch(tt::Event::kStart);
+  e.snapshot(snap);
+
+  const tt::Event moves[] = {tt::Event::kMoveLeft, tt::Event::kMoveRight,
+                             tt::Event::kRotate, tt::Event::kMoveDown,
+                             tt::Event::kDrop};
+  unsigned r = 99;
+  AllocScope scope;
+  for (int t = 0; t < 100000; ++t) {
+    if (e.state() == tt::State::kGameOver) e.dispatch(tt::Event::kStart);
+    r = r * 1103515245u + 12345u;
+    if ((r >> 29) == 0) e.dispatch(moves[(r >> 16) % 5]);
+    e.dispatch(tt::Event::kTick);
+    if ((t & 63) == 0) e.snapshot(snap);
+  }
+  EXPECT_EQ(scope.count(), 0);
+}
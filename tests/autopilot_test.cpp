@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "alloc_counter.h"
+#include "brick_game/snake/autopilot.h"
+
+using namespace s21::snake;
+
+namespace {
+
+// Доигрывает партию: лимит тиков должен остаться недостигнутым
+RunResult finish(Autopilot& pilot, Engine& e, int max_ticks = 1 << 20) {
+  e.dispatch(Event::kStart);
+  const RunResult r = e.run(max_ticks, pilot);
+  EXPECT_NE(r.reason, StopReason::kTickCap)
+      << e.width() << "x" << e.height() << (e.wrap() ? " wrap" : "")
+      << ": length " << e.length();
+  return r;
+}
+
+}  // namespace
+
+TEST(Autopilot, FinishesWalledBoard) {
+  Autopilot pilot;
+  for (unsigned seed = 1; seed <= 3; ++seed) {
+    Engine e{Config{20, 20, seed, false, {}, false}};
+    const RunResult r = finish(pilot, e);
+    EXPECT_LT(r.ticks, 100 * 400) << "seed " << seed;
+    EXPECT_GE(e.length(), 390u) << "seed " << seed;
+  }
+}
+
+TEST(Autopilot, FinishesTorusAndOddBoards) {
+  Autopilot pilot;
+  const Config boards[] = {Config{16, 16, 4, true, {}, false},
+                           Config{9, 7, 5, false, {}, false},
+                           Config{11, 5, 6, true, {}, false}};
+  for (const Config& cfg : boards) {
+    Engine e{cfg};
+    (void)finish(pilot, e);
+    EXPECT_GE(e.length(),
+              static_cast<std::size_t>(cfg.width * cfg.height * 9 / 10));
+  }
+}
+
+TEST(Autopilot, ReproducibleAcrossThreads) {
+  RunnerConfig cfg;
+  cfg.board = Config{10, 10, 0, false, {}, false};
+  cfg.games = 24;
+  cfg.max_ticks = 10000;
+  cfg.chunk = 4;
+  cfg.threads = 1;
+  const RunStats one = runGames(cfg, autopilotPolicy());
+  cfg.threads = 4;
+  EXPECT_EQ(runGames(cfg, autopilotPolicy()), one);
+  // Каждая партия закончилась сама: смертью или полным полем
+  EXPECT_LT(one.max_ticks, cfg.max_ticks);
+  EXPECT_GT(one.meanLength(), 95.0);
+}
+
+TEST(Autopilot, DecisionsDoNotAllocate) {
+  Engine e{Config{20, 20, 8, false, {}, false}};
+  e.dispatch(Event::kStart);
+  Autopilot pilot;
+  (void)e.run(300, pilot);
+  ASSERT_EQ(e.state(), State::kRunning);
+
+  alloc_counter::AllocScope scope;
+  (void)e.run(300, pilot);
+  EXPECT_EQ(scope.count(), 0);
+}
+
+TEST(Autopilot, StallFallbackDoesNotAllocate) {
+  Engine e{Config{10, 10, 9, false, {}, false}};
+  e.dispatch(Event::kStart);
+  Autopilot pilot;
+  (void)e.run(1, pilot);
+
+  // Конец партии на почти полном поле идет через поиск по следу тела
+  alloc_counter::AllocScope scope;
+  const RunResult r = e.run(1 << 20, pilot);
+  EXPECT_EQ(scope.count(), 0);
+  EXPECT_NE(r.reason, StopReason::kTickCap);
+}
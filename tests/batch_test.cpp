@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "brick_game/snake/backend.h"
+#include "brick_game/snake/batch.h"
+#include "brick_game/snake/rules.h"
+
+using namespace s21::snake;
+
+class SnakeBatchKernel
+    : public ::testing::TestWithParam<std::tuple<BatchKernel, bool>> {};
+
+TEST_P(SnakeBatchKernel, MatchesIndependentEngines) {
+  const auto [kernel, wrap] = GetParam();
+  if (!SnakeBatch::kernelSupported(kernel))
+    GTEST_SKIP() << "kernel not supported on this CPU";
+  // 61 партия: неполный последний вектор проходит через скалярный хвост
+  const int n = 61, w = 9, h = 8;
+  SnakeBatch batch(n, w, h, wrap);
+  ASSERT_TRUE(batch.setKernel(kernel));
+  std::vector<std::unique_ptr<Engine>> engines;
+  for (int g = 0; g < n; ++g) {
+    const unsigned seed = 1000u + g * 7919u;
+    batch.reset(g, seed);
+    engines.push_back(
+        std::make_unique<Engine>(Config{w, h, seed, wrap, {}, false}));
+    engines.back()->dispatch(Event::kStart);
+  }
+
+  std::vector<Direction> actions(n);
+  unsigned r = 99, next_seed = 1;
+  int finished = 0;
+  for (int t = 0; t < 3000; ++t) {
+    for (int g = 0; g < n; ++g) {
+      if (batch.state(g) == State::kGameOver) {
+        ++finished;
+        batch.reset(g, next_seed);
+        engines[g] = std::make_unique<Engine>(
+            Config{w, h, next_seed++, wrap, {}, false});
+        engines[g]->dispatch(Event::kStart);
+      }
+      r = r * 1103515245u + 12345u;
+      // Чаще продолжаем прямо, чтобы партии жили дольше
+      actions[g] = (r >> 28) < 12 ? batch.direction(g)
+                                  : static_cast<Direction>((r >> 16) % 4);
+    }
+    batch.step(actions);
+
+    for (int g = 0; g < n; ++g) {
+      Engine& e = *engines[g];
+      if (e.state() == State::kRunning) {
+        e.dispatch(rules::moveEvent(actions[g]));
+        e.dispatch(Event::kTick);
+      }
+      auto v = e.view();
+      ASSERT_EQ(batch.state(g), v.state) << "game " << g << " tick " << t;
+      ASSERT_EQ(batch.score(g), v.score);
+      ASSERT_EQ(batch.level(g), v.level);
+      ASSERT_EQ(batch.food(g), v.food);
+      ASSERT_EQ(batch.length(g), (int)v.snake.size());
+      ASSERT_EQ(batch.freeCells(g), (int)e.freeCells());
+      for (int i = 0; i < batch.length(g); ++i) {
+        ASSERT_EQ(batch.segment(g, i).x, v.snake[i].x);
+        ASSERT_EQ(batch.segment(g, i).y, v.snake[i].y);
+      }
+      for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+          ASSERT_EQ(batch.cell(g, x, y), v.grid[y * w + x]);
+    }
+  }
+  EXPECT_GT(finished, n);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Kernels, SnakeBatchKernel,
+    ::testing::Combine(::testing::Values(BatchKernel::kScalar,
+                                         BatchKernel::kSse2,
+                                         BatchKernel::kAvx2),
+                       ::testing::Bool()));
+
+TEST(SnakeBatch, AutoPicksScalarKernel) {
+  SnakeBatch batch(4, 10, 10);
+  EXPECT_EQ(batch.kernel(), BatchKernel::kScalar);
+  if (SnakeBatch::kernelSupported(BatchKernel::kAvx2)) {
+    EXPECT_TRUE(batch.setKernel(BatchKernel::kAvx2));
+    EXPECT_EQ(batch.kernel(), BatchKernel::kAvx2);
+  }
+  EXPECT_TRUE(batch.setKernel(BatchKernel::kAuto));
+  EXPECT_EQ(batch.kernel(), BatchKernel::kScalar);
+}
+
+TEST(SnakeBatch, RejectsMismatchedActionsAndHugeBatches) {
+  SnakeBatch batch(4, 10, 10);
+  for (int g = 0; g < 4; ++g) batch.reset(g, 1u + g);
+  const std::vector<Direction> few(3, Direction::kRight), many(5);
+  EXPECT_THROW(batch.step(few), std::invalid_argument);
+  EXPECT_THROW(batch.step(many), std::invalid_argument);
+
+  // 2^20 партий 64x64 — 2^32 клеток: индексы не влезают в int
+  EXPECT_THROW(SnakeBatch(1 << 20, 64, 64), std::invalid_argument);
+}
+
+TEST(SnakeBatch, RejectsGameIndexOutOfRange) {
+  SnakeBatch batch(4, 10, 10);
+  EXPECT_THROW(batch.reset(-1, 1), std::out_of_range);
+  EXPECT_THROW(batch.reset(4, 1), std::out_of_range);
+  batch.reset(3, 1);
+  EXPECT_EQ(batch.state(3), State::kRunning);
+  EXPECT_THROW((void)batch.state(4), std::out_of_range);
+  EXPECT_THROW((void)batch.score(-1), std::out_of_range);
+  EXPECT_THROW((void)batch.head(4), std::out_of_range);
+  EXPECT_THROW((void)batch.food(4), std::out_of_range);
+  EXPECT_THROW((void)batch.segment(3, batch.length(3)), std::out_of_range);
+  EXPECT_THROW((void)batch.cell(3, 10, 0), std::out_of_range);
+}
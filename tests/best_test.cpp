@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
 #include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
 
 #include "brick_game/snake/backend.h"
 using namespace s21::snake;
@@ -91,4 +94,85 @@ TEST(BestScore, PersistsAcrossRuns) {
   }
 
   std::remove(path.c_str());
-}
\ No newline at end of file
+}
+namespace {
+
+// Доводит партию до GameOver со счетом не меньше target
+void playUntilDeath(Engine& e, int target) {
+  e.dispatch(Event::kStart);
+  for (int guard = 0; guard < 3000 && e.state() == State::kRunning; ++guard) {
+    if (e.snapshot().score >= target) break;
+    smartStepTowardFood(e);
+  }
+  for (int i = 0; i < 200 && e.state() == State::kRunning; ++i)
+    e.dispatch(Event::kTick);
+}
+
+class RecordingStore : public BestStore {
+ public:
+  explicit RecordingStore(int initial) : initial_(initial) {}
+  int load() override {
+    ++loads;
+    return initial_;
+  }
+  void save(int best) override { saved.push_back(best); }
+
+  int loads{0};
+  std::vector<int> saved;
+
+ private:
+  int initial_;
+};
+
+}  // namespace
+
+TEST(BestScore, SimulationModeNeverTouchesFile) {
+  const std::string path = "tmp_best_sim.txt";
+  {
+    std::ofstream(path) << 50 << "\n";
+  }
+  {
+    Engine e{Config{10, 10, 42, false, path, false}};
+    EXPECT_EQ(e.snapshot().best, 0);
+    playUntilDeath(e, 2);
+    EXPECT_EQ(e.state(), State::kGameOver);
+    EXPECT_GE(e.snapshot().best, 2);
+  }
+  std::ifstream in(path);
+  int v = 0;
+  in >> v;
+  EXPECT_EQ(v, 50);
+  std::remove(path.c_str());
+}
+
+TEST(BestScore, SinkReplacesFile) {
+  const std::string path = "tmp_best_sink.txt";
+  std::remove(path.c_str());
+  RecordingStore store{1};
+  {
+    Engine e{Config{10, 10, 42, false, path, true, &store}};
+    EXPECT_EQ(store.loads, 1);
+    EXPECT_EQ(e.snapshot().best, 1);
+    playUntilDeath(e, 3);
+    ASSERT_EQ(e.state(), State::kGameOver);
+    const int score = e.snapshot().score;
+    ASSERT_GT(score, 1);
+    ASSERT_EQ(store.saved.size(), 1u);
+    EXPECT_EQ(store.saved.back(), score);
+
+    // Копии не сообщают приемнику о своих рекордах
+    Engine copy = e;
+    copy.dispatch(Event::kStart);
+    playUntilDeath(copy, score + 1);
+  }
+  EXPECT_EQ(store.saved.size(), 1u);
+  EXPECT_FALSE(std::ifstream(path).good());
+}
+
+TEST(BestScore, MemoryStoreKeepsMaximum) {
+  MemoryBestStore store{3};
+  store.save(2);
+  EXPECT_EQ(store.best(), 3);
+  store.save(7);
+  EXPECT_EQ(store.load(), 7);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "brick_game/snake/backend.h"
+
+using namespace s21::snake;
+
+TEST(SnakeChanges, ReplayingChangesReproducesGrid) {
+  Engine e{Config{9, 7, 31, false, {}, false}};
+  auto v = e.view();
+  std::vector<Cell::Type> mirror(v.grid.begin(), v.grid.end());
+  int score = v.score;
+  State state = v.state;
+
+  const Event events[] = {Event::kMoveUp,   Event::kMoveLeft, Event::kTick,
+                          Event::kMoveDown, Event::kTick,     Event::kMoveRight,
+                          Event::kTick,     Event::kTick,     Event::kStart};
+  unsigned r = 5;
+  for (int t = 0; t < 20000; ++t) {
+    r = r * 1103515245u + 12345u;
+    e.dispatch(events[(r >> 16) % 9]);
+
+    const ChangeList& ch = e.changes();
+    v = e.view();
+    if (ch.full_redraw) {
+      mirror.assign(v.grid.begin(), v.grid.end());
+    } else {
+      ASSERT_LE(ch.count, ChangeList::kCapacity);
+      for (const CellChange& c : ch.cellChanges())
+        mirror[c.pos.y * v.width + c.pos.x] = c.type;
+    }
+    ASSERT_TRUE(std::equal(mirror.begin(), mirror.end(), v.grid.begin()))
+        << "step " << t;
+
+    EXPECT_EQ(ch.score_changed, v.score != score);
+    EXPECT_EQ(ch.state_changed, v.state != state);
+    score = v.score;
+    state = v.state;
+  }
+}
+
+TEST(SnakeChanges, PlainTickTouchesHeadAndTail) {
+  Engine e{Config{20, 20, 0, false, {}, false}};
+  e.dispatch(Event::kStart);
+  EXPECT_TRUE(e.changes().full_redraw);
+  EXPECT_TRUE(e.changes().state_changed);
+
+  e.dispatch(Event::kTick);
+  const ChangeList& ch = e.changes();
+  ASSERT_EQ(ch.count, 2);
+  EXPECT_EQ(ch.cells[0].type, Cell::kEmpty);
+  EXPECT_EQ(ch.cells[1].type, Cell::kSnake);
+  EXPECT_EQ(ch.cells[1].pos.x, e.head().x);
+  EXPECT_FALSE(ch.full_redraw);
+  EXPECT_FALSE(ch.state_changed);
+}
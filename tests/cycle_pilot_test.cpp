@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include "brick_game/snake/cycle_pilot.h"
+
+using namespace s21::snake;
+
+namespace {
+
+// Проводит партию до конца и проверяет, что поле заполнено
+void expectFills(const Config& cfg) {
+  CyclePilot pilot(cfg.width, cfg.height);
+  Engine e{cfg};
+  e.dispatch(Event::kStart);
+  RunResult r;
+  do {
+    r = e.run(1 << 20, pilot);
+  } while (r.reason == StopReason::kTickCap);
+  EXPECT_EQ(r.reason, StopReason::kBoardFull)
+      << cfg.width << "x" << cfg.height << (cfg.wrap ? " wrap" : "");
+  EXPECT_EQ(e.length(), static_cast<std::size_t>(cfg.width * cfg.height));
+}
+
+}  // namespace
+
+TEST(CyclePilot, CycleVisitsEveryCellThroughNeighbors) {
+  for (auto [w, h] : {std::pair{20, 20}, {10, 7}, {7, 10}, {6, 10}, {4, 4}}) {
+    CyclePilot pilot(w, h);
+    std::vector<int> at(w * h, -1);
+    for (int y = 0; y < h; ++y)
+      for (int x = 0; x < w; ++x) {
+        const int k = pilot.cycleIndex(x, y);
+        ASSERT_GE(k, 0);
+        ASSERT_LT(k, w * h);
+        ASSERT_EQ(at[k], -1) << "index used twice";
+        at[k] = y * w + x;
+      }
+    for (int k = 0; k < w * h; ++k) {
+      const int a = at[k], b = at[(k + 1) % (w * h)];
+      EXPECT_EQ(std::abs(a % w - b % w) + std::abs(a / w - b / w), 1)
+          << w << "x" << h << " step " << k;
+    }
+  }
+}
+
+TEST(CyclePilot, RejectsOddBoards) {
+  EXPECT_THROW(CyclePilot(9, 7), std::invalid_argument);
+  EXPECT_THROW(CyclePilot(2, 8), std::invalid_argument);
+}
+
+TEST(CyclePilot, FillsSmallBoards) {
+  expectFills(Config{20, 20, 1, false, {}, false});
+  expectFills(Config{10, 7, 2, false, {}, false});
+  expectFills(Config{6, 10, 3, false, {}, false});
+  expectFills(Config{5, 4, 4, false, {}, false});
+  expectFills(Config{8, 8, 5, true, {}, false});
+  expectFills(Config{9, 6, 6, true, {}, false});
+}
+
+TEST(CyclePilot, Fills100x100) {
+  expectFills(Config{100, 100, 7, false, {}, false});
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "alloc_counter.h"
+#include "brick_game/snake/backend.h"
+#include "brick_game/snake/observation.h"
+#include "brick_game/snake/rules.h"
+#include "brick_game/snake/snake_env.h"
+
+using namespace s21::snake;
+
+namespace {
+
+struct EnvDeleter {
+  void operator()(snake_env* e) const { snake_env_destroy(e); }
+};
+using EnvPtr = std::unique_ptr<snake_env, EnvDeleter>;
+
+}  // namespace
+
+TEST(SnakeEnv, RejectsBadBoards) {
+  EXPECT_EQ(snake_env_create(4, 2, 20, 0), nullptr);
+  EXPECT_EQ(snake_env_create(-1, 20, 20, 0), nullptr);
+  // Клетки всех партий помещаются в int, а 7 плоскостей наблюдения — нет
+  EXPECT_EQ(snake_env_create(1 << 17, 64, 64, 0), nullptr);
+  EXPECT_EQ(snake_env_create(1, 0x7FFF, 0x7FFF, 0), nullptr);
+  EXPECT_EQ(snake_env_count(nullptr), -1);
+  EXPECT_EQ(snake_env_step(nullptr, nullptr, nullptr, nullptr, nullptr), -1);
+}
+
+// Каждая партия среды совпадает с Engine, который перезапускают с
+// seed + k * N после каждой гибели
+TEST(SnakeEnv, MatchesEnginesWithAutoReset) {
+  constexpr int kN = 5, kW = 8, kH = 8;
+  EnvPtr env{snake_env_create(kN, kW, kH, 0)};
+  ASSERT_NE(env, nullptr);
+  const int obs_size = snake_env_obs_size(env.get());
+  ASSERT_EQ(obs_size, static_cast<int>(observationSize(kW, kH)));
+
+  std::vector<std::uint32_t> seeds(kN);
+  std::vector<Engine> ref;
+  std::vector<std::uint32_t> next(kN);
+  for (int g = 0; g < kN; ++g) {
+    seeds[g] = 100u + g;
+    next[g] = seeds[g] + kN;
+    ref.emplace_back(Config{kW, kH, seeds[g], false, {}, false});
+    ref.back().dispatch(Event::kStart);
+  }
+  std::vector<std::uint8_t> obs(kN * obs_size), one(obs_size);
+  ASSERT_EQ(snake_env_reset(env.get(), seeds.data(), obs.data()), 0);
+
+  std::vector<std::int32_t> actions(kN), scores(kN);
+  std::vector<float> rewards(kN);
+  std::vector<std::uint8_t> dones(kN);
+  unsigned r = 1;
+  int episodes = 0;
+  for (int t = 0; t < 2000; ++t) {
+    for (int g = 0; g < kN; ++g) {
+      r = r * 1103515245u + 12345u;
+      actions[g] = static_cast<std::int32_t>((r >> 16) % 5);  // 4 — прямо
+    }
+    ASSERT_EQ(snake_env_step(env.get(), actions.data(), obs.data(),
+                             rewards.data(), dones.data()),
+              0);
+    ASSERT_EQ(snake_env_scores(env.get(), scores.data()), 0);
+
+    for (int g = 0; g < kN; ++g) {
+      Engine& e = ref[g];
+      const int before = e.snapshot().score;
+      if (actions[g] < 4)
+        e.dispatch(rules::moveEvent(static_cast<Direction>(actions[g])));
+      e.dispatch(Event::kTick);
+      const bool dead = e.state() != State::kRunning;
+      const bool done = dead || e.freeCells() == 0;
+      ASSERT_EQ(dones[g], done ? 1 : 0) << "game " << g << " t " << t;
+      ASSERT_EQ(scores[g], e.snapshot().score);
+      ASSERT_FLOAT_EQ(rewards[g],
+                      e.snapshot().score - before - (dead ? 1.0f : 0.0f));
+      if (done) {
+        ++episodes;
+        e = Engine{Config{kW, kH, next[g], false, {}, false}};
+        e.dispatch(Event::kStart);
+        next[g] += kN;
+      }
+      ASSERT_TRUE(e.observe(one));
+      ASSERT_TRUE(std::equal(one.begin(), one.end(),
+                             obs.begin() + g * obs_size));
+    }
+  }
+  EXPECT_GT(episodes, kN);
+}
+
+TEST(SnakeEnv, StepDoesNotAllocate) {
+  constexpr int kN = 64;
+  EnvPtr env{snake_env_create(kN, 10, 10, 1)};
+  ASSERT_NE(env, nullptr);
+  std::vector<std::uint32_t> seeds(kN);
+  for (int g = 0; g < kN; ++g) seeds[g] = 1u + g;
+  const int obs_size = snake_env_obs_size(env.get());
+  std::vector<std::uint8_t> obs(kN * obs_size), dones(kN);
+  std::vector<float> rewards(kN), obs_f(kN * obs_size);
+  std::vector<std::int32_t> actions(kN);
+  ASSERT_EQ(snake_env_reset(env.get(), seeds.data(), obs.data()), 0);
+
+  alloc_counter::AllocScope scope;
+  for (int t = 0; t < 1000; ++t) {
+    for (int g = 0; g < kN; ++g) actions[g] = (t * 7 + g) % 4;
+    snake_env_step(env.get(), actions.data(), obs.data(), rewards.data(),
+                   dones.data());
+  }
+  snake_env_observe_f32(env.get(), obs_f.data());
+  EXPECT_EQ(scope.count(), 0);
+}
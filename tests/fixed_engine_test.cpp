@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "brick_game/snake/backend.h"
+#include "brick_game/snake/fixed_engine.h"
+#include "brick_game/snake/rules.h"
+
+using namespace s21::snake;
+
+namespace {
+
+// Прогоняет Engine и FixedEngine одним потоком событий и сверяет их
+// после каждого события. Партии перезапускаются после GameOver.
+template <int W, int H>
+void expectSameGames(bool wrap) {
+  for (unsigned seed = 1; seed <= 12; ++seed) {
+    Engine ref{Config{W, H, seed, wrap, {}, false}};
+    auto fixed = std::make_unique<FixedEngine<W, H>>(seed, wrap);
+    unsigned r = seed * 2654435761u;
+    for (int t = 0; t < 4000; ++t) {
+      Event ev = Event::kTick;
+      if (ref.state() != State::kRunning) {
+        ev = Event::kStart;
+      } else if ((r = r * 1103515245u + 12345u) >> 29 == 0) {
+        ev = rules::moveEvent(static_cast<Direction>((r >> 16) % 4));
+      }
+      ref.dispatch(ev);
+      fixed->dispatch(ev);
+
+      const SnapshotView v = ref.view();
+      ASSERT_EQ(fixed->state(), v.state) << "seed " << seed << " t " << t;
+      ASSERT_EQ(fixed->score(), v.score);
+      ASSERT_EQ(fixed->level(), v.level);
+      ASSERT_EQ(fixed->speedMs(), v.speed_ms);
+      ASSERT_EQ(fixed->best(), v.best);
+      ASSERT_EQ(fixed->food(), v.food);
+      ASSERT_EQ(fixed->length(), ref.length());
+      ASSERT_EQ(fixed->freeCells(), ref.freeCells());
+      for (int i = 0; i < static_cast<int>(v.snake.size()); ++i) {
+        ASSERT_EQ(fixed->segment(i).x, v.snake[i].x);
+        ASSERT_EQ(fixed->segment(i).y, v.snake[i].y);
+      }
+      for (int y = 0; y < H; ++y)
+        for (int x = 0; x < W; ++x)
+          ASSERT_EQ(fixed->cell(x, y), v.grid[y * W + x]);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(FixedEngine, MatchesEngineOnDefaultBoard) {
+  expectSameGames<20, 20>(false);
+}
+
+TEST(FixedEngine, MatchesEngineOnTrainingBoard) {
+  expectSameGames<10, 10>(false);
+}
+
+TEST(FixedEngine, MatchesEngineWithWrap) {
+  expectSameGames<16, 16>(true);
+  expectSameGames<12, 9>(true);
+}
+
+TEST(FixedEngine, MatchesEngineWithWideRows) {
+  // 70 клеток в строке не помещаются в uint64_t: общий битовый массив
+  static_assert(!FixedEngine<70, 6>::kRowBits);
+  static_assert(FixedEngine<64, 6>::kRowBits);
+  expectSameGames<70, 6>(false);
+}
+
+TEST(FixedEngine, RunMatchesEngineRun) {
+  auto policy = [](const auto& e) {
+    const Point h = e.head();
+    const unsigned mix = h.x * 73856093u ^ h.y * 19349663u;
+    return (mix >> 7) % 5 < 3 ? e.direction()
+                              : static_cast<Direction>(mix % 4);
+  };
+  for (unsigned seed = 1; seed <= 20; ++seed) {
+    Engine ref{Config{20, 20, seed, false, {}, false}};
+    FixedEngine<20, 20> fixed{seed};
+    ref.dispatch(Event::kStart);
+    fixed.dispatch(Event::kStart);
+    const RunResult a = ref.run(10000, policy);
+    const RunResult b = fixed.run(10000, policy);
+    EXPECT_EQ(a.reason, b.reason);
+    EXPECT_EQ(a.ticks, b.ticks);
+    EXPECT_EQ(ref.view().score, fixed.score());
+  }
+}
@@ -1,11 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "brick_game/snake/backend.h"
+#include "brick_game/snake/cycle_pilot.h"
 
 using namespace s21::snake;
 
 TEST(SnakeFood, FoodExistsAfterStart) {
-  Engine e{Config{10, 10, 123, false}};
+  Engine e{Config{10, 10, 123, false, {}, false}};
   e.dispatch(Event::kStart);
   auto snap = e.snapshot();
 
@@ -19,7 +22,7 @@ TEST(SnakeFood, FoodExistsAfterStart) {
 }
 
 TEST(SnakeFood, EatIncreasesScoreAndGrows) {
-  Engine e{Config{12, 8, 777, false}};
+  Engine e{Config{12, 8, 777, false, {}, false}};
   e.dispatch(Event::kStart);
 
   auto s0 = e.snapshot();
@@ -51,4 +54,79 @@ TEST(SnakeFood, EatIncreasesScoreAndGrows) {
     }
   }
   EXPECT_TRUE(ate);
-}
\ No newline at end of file
+}
+TEST(SnakeFood, FreeCellCountTracksSnake) {
+  Engine e{Config{10, 10, 99, false, {}, false}};
+  e.dispatch(Event::kStart);
+  const Event moves[] = {Event::kMoveUp, Event::kMoveLeft, Event::kMoveDown,
+                         Event::kMoveRight};
+
+  unsigned r = 12345;
+  for (int t = 0; t < 2000; ++t) {
+    if (e.state() != State::kRunning) e.dispatch(Event::kStart);
+    r = r * 1103515245u + 12345u;
+    e.dispatch(moves[(r >> 16) % 4]);
+    e.dispatch(Event::kTick);
+
+    auto s = e.snapshot();
+    ASSERT_EQ(e.freeCells(), (std::size_t)(s.width * s.height) - s.snake.size());
+    for (auto [x, y] : s.snake)
+      ASSERT_FALSE(x == s.food.first && y == s.food.second);
+  }
+}
+
+TEST(SnakeFood, PlacementIsUniformOverFreeCells) {
+  const int w = 5, h = 5, seeds = 22000;
+  std::vector<int> hits(w * h, 0);
+  for (int i = 1; i <= seeds; ++i) {
+    Engine e{Config{w, h, (unsigned)i * 2654435761u, false, {}, false}};
+    auto [fx, fy] = e.snapshot().food;
+    ++hits[fy * w + fx];
+  }
+
+  // 22 свободные клетки — в среднем по 1000 попаданий на каждую
+  int free = 0;
+  for (int v : hits) {
+    if (v == 0) continue;
+    ++free;
+    EXPECT_GT(v, 800);
+    EXPECT_LT(v, 1200);
+  }
+  EXPECT_EQ(free, w * h - 3);
+}
+
+TEST(SnakeFood, PlacementIsUniformOnNearlyFullBoard) {
+  // Партии 8x8 с пилотом по циклу доходят до полного поля. Когда
+  // свободно k <= 6 клеток (поле заполнено на 90% и больше), еда
+  // ставится новой: ее номер среди свободных клеток в порядке обхода
+  // поля должен быть равномерен в [0, k)
+  const int w = 8, h = 8, games = 2000, max_free = 6;
+  std::vector<std::vector<int>> hits(max_free + 1);
+  for (int k = 2; k <= max_free; ++k) hits[k].assign(k, 0);
+
+  CyclePilot pilot(w, h);
+  for (int g = 1; g <= games; ++g) {
+    Engine e{Config{w, h, (unsigned)g * 2654435761u, false, {}, false}};
+    e.dispatch(Event::kStart);
+    for (StopReason r = StopReason::kTickCap; r == StopReason::kTickCap;) {
+      const int score = e.snapshot().score;
+      r = e.run(1, pilot).reason;
+      const int k = static_cast<int>(e.freeCells());
+      if (e.snapshot().score == score || k < 2 || k > max_free) continue;
+      const auto [fx, fy] = e.food();
+      int rank = 0;
+      for (int i = 0; i < fy * w + fx; ++i)
+        if (!e.isSnakeCell(i % w, i / w)) ++rank;
+      ++hits[k][rank];
+    }
+  }
+
+  // Хи-квадрат по всем k: 1 + 2 + 3 + 4 + 5 = 15 степеней свободы,
+  // 37.7 — критическое значение для p = 0.001
+  double chi2 = 0;
+  for (int k = 2; k <= max_free; ++k) {
+    const double expected = static_cast<double>(games) / k;
+    for (int v : hits[k]) chi2 += (v - expected) * (v - expected) / expected;
+  }
+  EXPECT_LT(chi2, 37.7);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "brick_game/snake/backend.h"
+
+using namespace s21::snake;
+
+static std::vector<Cell::Type> rebuildGrid(const Snapshot& s) {
+  std::vector<Cell::Type> g(s.width * s.height, Cell::kEmpty);
+  for (auto [x, y] : s.snake) g[y * s.width + x] = Cell::kSnake;
+  auto [fx, fy] = s.food;
+  if (fx >= 0 && fy >= 0) g[fy * s.width + fx] = Cell::kFood;
+  return g;
+}
+
+TEST(SnakeGrid, IncrementalGridMatchesRebuild) {
+  const Event moves[] = {Event::kMoveUp, Event::kMoveDown, Event::kMoveLeft,
+                         Event::kMoveRight};
+
+  for (unsigned seed = 1; seed <= 20; ++seed) {
+    Engine e{Config{7 + (int)seed % 5, 6 + (int)seed % 4, seed, false, {},
+                    false}};
+    e.dispatch(Event::kStart);
+
+    unsigned r = seed * 2654435761u;
+    for (int t = 0; t < 5000; ++t) {
+      r ^= r << 13;
+      r ^= r >> 17;
+      r ^= r << 5;
+      if (e.state() == State::kGameOver)
+        e.dispatch((r & 1) ? Event::kStart : Event::kReset);
+      if (e.state() == State::kReady) e.dispatch(Event::kStart);
+      e.dispatch(moves[(r >> 8) % 4]);
+      e.dispatch(Event::kTick);
+
+      auto s = e.snapshot();
+      ASSERT_EQ(s.grid, rebuildGrid(s)) << "seed " << seed << " tick " << t;
+    }
+  }
+}
+
+TEST(SnakeGrid, CellsAndBodyAreCompact) {
+  static_assert(sizeof(Cell::Type) == 1);
+  static_assert(sizeof(Point) == 2 * sizeof(Coord));
+
+  Engine e{Config{40, 30, 3, false, {}, false}};
+  auto s = e.snapshot();
+  EXPECT_EQ(s.grid.size() * sizeof(s.grid[0]), 40u * 30u);
+  EXPECT_EQ(sizeof(s.snake[0]), 4u);
+
+  EXPECT_THROW((Engine{Config{40000, 10, 0, false, {}, false}}),
+               std::invalid_argument);
+}
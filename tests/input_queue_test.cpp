@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "brick_game/snake/backend.h"
+
+using namespace s21::snake;
+
+TEST(InputQueue, ValidatesAgainstLastQueuedTurn) {
+  InputQueue q;
+  EXPECT_FALSE(q.push(Direction::kRight, Direction::kLeft));   // разворот
+  EXPECT_FALSE(q.push(Direction::kRight, Direction::kRight));  // повтор
+  EXPECT_TRUE(q.push(Direction::kRight, Direction::kUp));
+  EXPECT_FALSE(q.push(Direction::kRight, Direction::kDown));   // против Up
+  EXPECT_TRUE(q.push(Direction::kRight, Direction::kLeft));    // после Up
+  EXPECT_EQ(q.size(), 2u);
+  EXPECT_EQ(q.next(Direction::kRight), Direction::kUp);
+  EXPECT_EQ(q.next(Direction::kUp), Direction::kLeft);
+  EXPECT_EQ(q.next(Direction::kLeft), Direction::kLeft);
+}
+
+TEST(InputQueue, DropsPressesBeyondCapacity) {
+  InputQueue q;
+  const Direction zigzag[] = {Direction::kUp, Direction::kRight,
+                              Direction::kDown, Direction::kRight,
+                              Direction::kUp, Direction::kRight};
+  std::size_t accepted = 0;
+  for (Direction d : zigzag) accepted += q.push(Direction::kLeft, d);
+  EXPECT_EQ(accepted, InputQueue::kCapacity);
+  EXPECT_EQ(q.size(), InputQueue::kCapacity);
+}
+
+TEST(SnakeInput, TwoQuickTurnsDoNotReverseIntoNeck) {
+  Engine e{Config{20, 20, 0, false, {}, false}};
+  e.dispatch(Event::kStart);
+  const Point start = e.head();
+
+  // Движемся вправо; "вверх, влево" до одного тика
+  e.dispatch(Event::kMoveUp);
+  e.dispatch(Event::kMoveLeft);
+  EXPECT_EQ(e.direction(), Direction::kRight);
+  EXPECT_EQ(e.queuedMoves(), 2u);
+
+  e.dispatch(Event::kTick);
+  EXPECT_EQ(e.state(), State::kRunning);
+  EXPECT_EQ(e.head().x, start.x);
+  EXPECT_EQ(e.head().y, start.y - 1);
+
+  e.dispatch(Event::kTick);
+  EXPECT_EQ(e.state(), State::kRunning);
+  EXPECT_EQ(e.head().x, start.x - 1);
+  EXPECT_EQ(e.head().y, start.y - 1);
+  EXPECT_EQ(e.queuedMoves(), 0u);
+}
+
+TEST(SnakeInput, OneTurnPerTick) {
+  Engine e{Config{20, 20, 0, false, {}, false}};
+  e.dispatch(Event::kStart);
+  e.dispatch(Event::kMoveDown);
+  e.dispatch(Event::kMoveRight);
+  e.dispatch(Event::kTick);
+  EXPECT_EQ(e.direction(), Direction::kDown);
+  e.dispatch(Event::kTick);
+  EXPECT_EQ(e.direction(), Direction::kRight);
+}
+
+TEST(SnakeInput, QueueClearsOnRestart) {
+  Engine e{Config{20, 20, 0, false, {}, false}};
+  e.dispatch(Event::kStart);
+  e.dispatch(Event::kMoveUp);
+  e.dispatch(Event::kReset);
+  EXPECT_EQ(e.queuedMoves(), 0u);
+  e.dispatch(Event::kStart);
+  e.dispatch(Event::kTick);
+  EXPECT_EQ(e.direction(), Direction::kRight);
+}
+
+TEST(SnakeInput, MovesIgnoredWhilePaused) {
+  Engine e{Config{20, 20, 0, false, {}, false}};
+  e.dispatch(Event::kStart);
+  e.dispatch(Event::kPauseToggle);
+  e.dispatch(Event::kMoveUp);
+  EXPECT_EQ(e.queuedMoves(), 0u);
+}
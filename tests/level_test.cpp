@@ -56,7 +56,7 @@ static void smartStepTowardFood(Engine& e) {
 }
 
 TEST(Levels, LevelAndSpeedRespondToScore) {
-  Engine e{Config{12, 8, 123, false}};
+  Engine e{Config{12, 8, 123, false, {}, false}};
   e.dispatch(Event::kStart);
 
   int lastLevel = e.snapshot().level;
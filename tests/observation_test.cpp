@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "alloc_counter.h"
+#include "brick_game/snake/batch.h"
+#include "brick_game/snake/observation.h"
+#include "brick_game/snake/rules.h"
+
+using namespace s21::snake;
+
+namespace {
+
+// Сверяет наблюдение со снимком движка
+template <class T>
+void expectMatchesSnapshot(const Engine& e, const T* obs) {
+  const Snapshot s = e.snapshot();
+  const int cells = s.width * s.height;
+  auto at = [&](ObsPlane p, int i) {
+    return obs[static_cast<int>(p) * cells + i];
+  };
+  for (int i = 0; i < cells; ++i) {
+    EXPECT_EQ(at(ObsPlane::kBody, i), s.grid[i] == Cell::kSnake ? 1 : 0);
+    EXPECT_EQ(at(ObsPlane::kFood, i), s.grid[i] == Cell::kFood ? 1 : 0);
+    const int head = s.snake.front().second * s.width + s.snake.front().first;
+    EXPECT_EQ(at(ObsPlane::kHead, i), i == head ? 1 : 0);
+    for (int d = 0; d < 4; ++d) {
+      const int p = static_cast<int>(ObsPlane::kDirUp) + d;
+      EXPECT_EQ(at(static_cast<ObsPlane>(p), i), static_cast<int>(e.direction()) == d ? 1 : 0);
+    }
+  }
+}
+
+void drive(Engine& e, unsigned& r, int ticks) {
+  for (int t = 0; t < ticks && e.state() == State::kRunning; ++t) {
+    r = r * 1103515245u + 12345u;
+    if ((r >> 28) < 4)
+      e.dispatch(rules::moveEvent(static_cast<Direction>((r >> 16) % 4)));
+    e.dispatch(Event::kTick);
+  }
+}
+
+}  // namespace
+
+TEST(Observation, PlanesMatchSnapshot) {
+  Engine e{Config{12, 9, 5, false, {}, false}};
+  e.dispatch(Event::kStart);
+  std::vector<std::uint8_t> u8(observationSize(12, 9));
+  std::vector<float> f32(u8.size());
+  unsigned r = 3;
+  for (int step = 0; step < 20 && e.state() == State::kRunning; ++step) {
+    drive(e, r, 7);
+    ASSERT_TRUE(e.observe(u8));
+    ASSERT_TRUE(e.observe(f32));
+    expectMatchesSnapshot(e, u8.data());
+    expectMatchesSnapshot(e, f32.data());
+  }
+}
+
+TEST(Observation, RejectsShortBuffer) {
+  Engine e{Config{10, 10, 1, false, {}, false}};
+  std::vector<std::uint8_t> small(observationSize(10, 10) - 1);
+  EXPECT_FALSE(e.observe(small));
+}
+
+TEST(Observation, BatchOfEnginesIsConcatenation) {
+  std::vector<Engine> engines;
+  for (unsigned s = 1; s <= 4; ++s) {
+    engines.emplace_back(Config{10, 10, s, false, {}, false});
+    engines.back().dispatch(Event::kStart);
+    unsigned r = s;
+    drive(engines.back(), r, 15);
+  }
+  std::vector<const Engine*> ptrs;
+  for (const Engine& e : engines) ptrs.push_back(&e);
+
+  const std::size_t n = observationSize(10, 10);
+  std::vector<std::uint8_t> tensor(n * ptrs.size()), one(n);
+  ASSERT_TRUE(observeBatch(ptrs, tensor));
+  for (std::size_t i = 0; i < ptrs.size(); ++i) {
+    ASSERT_TRUE(ptrs[i]->observe(one));
+    EXPECT_TRUE(std::equal(one.begin(), one.end(), tensor.begin() + i * n));
+  }
+
+  Engine other{Config{12, 10, 1, false, {}, false}};
+  ptrs.push_back(&other);
+  tensor.resize(n * ptrs.size() * 2);
+  EXPECT_FALSE(observeBatch(ptrs, tensor));
+}
+
+TEST(Observation, SnakeBatchMatchesEngines) {
+  constexpr int kGames = 6, kW = 10, kH = 8;
+  SnakeBatch batch(kGames, kW, kH);
+  std::vector<Engine> engines;
+  for (int g = 0; g < kGames; ++g) {
+    batch.reset(g, 10u + g);
+    engines.emplace_back(Config{kW, kH, 10u + g, false, {}, false});
+    engines.back().dispatch(Event::kStart);
+  }
+
+  const std::size_t n = observationSize(kW, kH);
+  std::vector<float> tensor(n * kGames), one(n);
+  std::vector<Direction> actions(kGames);
+  unsigned r = 77;
+  for (int t = 0; t < 60; ++t) {
+    for (int g = 0; g < kGames; ++g) {
+      r = r * 1103515245u + 12345u;
+      actions[g] = static_cast<Direction>((r >> 16) % 4);
+      if (engines[g].state() == State::kRunning) {
+        engines[g].dispatch(rules::moveEvent(actions[g]));
+        engines[g].dispatch(Event::kTick);
+      }
+    }
+    batch.step(actions);
+
+    alloc_counter::AllocScope scope;
+    ASSERT_TRUE(batch.observe(tensor));
+    EXPECT_EQ(scope.count(), 0);
+    for (int g = 0; g < kGames; ++g) {
+      ASSERT_TRUE(engines[g].observe(one));
+      ASSERT_TRUE(std::equal(one.begin(), one.end(), tensor.begin() + g * n))
+          << "game " << g << " tick " << t;
+    }
+  }
+}
+
+TEST(Observation, DoesNotAllocate) {
+  Engine e{Config{20, 20, 9, false, {}, false}};
+  e.dispatch(Event::kStart);
+  std::vector<std::uint8_t> u8(observationSize(20, 20));
+  std::vector<float> f32(u8.size());
+  std::vector<const Engine*> ptrs{&e, &e};
+  std::vector<std::uint8_t> tensor(2 * u8.size());
+  alloc_counter::AllocScope scope;
+  EXPECT_TRUE(e.observe(u8));
+  EXPECT_TRUE(e.observe(f32));
+  EXPECT_TRUE(observeBatch(ptrs, tensor));
+  EXPECT_EQ(scope.count(), 0);
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "brick_game/common/persist.h"
+#include "brick_game/snake/backend.h"
+
+using namespace s21::snake;
+
+namespace {
+
+std::string readFile(const std::string& path) {
+  std::ifstream in(path);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+struct Loaded {
+  std::string data;
+  int found{-1};
+};
+
+void onLoaded(void* ctx, const char* data, std::size_t len, int found) {
+  auto* l = static_cast<Loaded*>(ctx);
+  l->data.assign(data ? data : "", len);
+  l->found = found;
+}
+
+}  // namespace
+
+TEST(Persist, AtomicWriteCreatesParents) {
+  const std::string dir = "tmp_persist_dir";
+  const std::string path = dir + "/sub/file.txt";
+  ASSERT_EQ(ps_write_atomic(path.c_str(), "abc", 3), 0);
+  EXPECT_EQ(readFile(path), "abc");
+  std::remove(path.c_str());
+  std::remove((dir + "/sub").c_str());
+  std::remove(dir.c_str());
+}
+
+TEST(Persist, LoadSeesEarlierWrites) {
+  const std::string path = "tmp_persist_order.txt";
+  std::remove(path.c_str());
+
+  Loaded before, after;
+  ASSERT_EQ(ps_load_async(path.c_str(), onLoaded, &before), 0);
+  ASSERT_EQ(ps_write_async(path.c_str(), "42\n", 3), 0);
+  ASSERT_EQ(ps_load_async(path.c_str(), onLoaded, &after), 0);
+  ps_flush();
+
+  EXPECT_EQ(before.found, 0);
+  EXPECT_EQ(after.found, 1);
+  EXPECT_EQ(after.data, "42\n");
+  std::remove(path.c_str());
+}
+
+TEST(Persist, PendingWritesCoalesce) {
+  const std::string path = "tmp_persist_coalesce.txt";
+  for (int i = 0; i <= 100; ++i) {
+    const std::string v = std::to_string(i);
+    ASSERT_EQ(ps_write_async(path.c_str(), v.data(), v.size()), 0);
+  }
+  ps_flush();
+  EXPECT_EQ(readFile(path), "100");
+  std::remove(path.c_str());
+}
+
+TEST(Persist, WritesDoNotCoalescePastLoads) {
+  const std::string path = "tmp_persist_barrier.txt";
+  std::remove(path.c_str());
+
+  // Рабочий поток занят, пока задания ниже не встанут в очередь
+  std::atomic<bool> release{false};
+  auto hold = [](void* ctx, const char*, std::size_t, int) {
+    auto* go = static_cast<std::atomic<bool>*>(ctx);
+    while (!go->load()) std::this_thread::yield();
+  };
+  ASSERT_EQ(ps_load_async(path.c_str(), hold, &release), 0);
+  Loaded between;
+  ASSERT_EQ(ps_write_async(path.c_str(), "1", 1), 0);
+  ASSERT_EQ(ps_load_async(path.c_str(), onLoaded, &between), 0);
+  ASSERT_EQ(ps_write_async(path.c_str(), "2", 1), 0);
+  release = true;
+  ps_flush();
+
+  EXPECT_EQ(between.data, "1");
+  EXPECT_EQ(readFile(path), "2");
+  std::remove(path.c_str());
+}
+
+TEST(Persist, SlotWritesKeepOrderWithLoads) {
+  const std::string path = "tmp_persist_slot.txt";
+  std::remove(path.c_str());
+  ps_slot* slot = ps_slot_create(path.c_str(), 8);
+  ASSERT_NE(slot, nullptr);
+  EXPECT_NE(ps_slot_write(slot, "too long!", 9), 0);
+
+  std::atomic<bool> release{false};
+  auto hold = [](void* ctx, const char*, std::size_t, int) {
+    auto* go = static_cast<std::atomic<bool>*>(ctx);
+    while (!go->load()) std::this_thread::yield();
+  };
+  ASSERT_EQ(ps_load_async(path.c_str(), hold, &release), 0);
+  Loaded between;
+  ASSERT_EQ(ps_slot_write(slot, "1", 1), 0);
+  ASSERT_EQ(ps_slot_write(slot, "2", 1), 0);
+  ASSERT_EQ(ps_load_async(path.c_str(), onLoaded, &between), 0);
+  ASSERT_EQ(ps_slot_write(slot, "3", 1), 0);
+  release = true;
+  ps_slot_destroy(slot);
+
+  EXPECT_EQ(between.data, "2");
+  EXPECT_EQ(readFile(path), "3");
+  std::remove(path.c_str());
+}
+
+TEST(Persist, ConcurrentAtomicWritesUseOwnTempFiles) {
+  const std::string path = "tmp_persist_race.txt";
+  std::atomic<int> failures{0};
+  auto writer = [&](const char* text) {
+    for (int i = 0; i < 200; ++i)
+      if (ps_write_atomic(path.c_str(), text, 3) != 0) ++failures;
+  };
+  std::thread other(writer, "bbb");
+  writer("aaa");
+  other.join();
+
+  EXPECT_EQ(failures.load(), 0);
+  const std::string last = readFile(path);
+  EXPECT_TRUE(last == "aaa" || last == "bbb") << last;
+  std::remove(path.c_str());
+}
+
+TEST(Persist, FileStoreRoundTrip) {
+  const std::string path = "tmp_persist_best.txt";
+  {
+    std::ofstream(path) << 7 << "\n";
+  }
+  {
+    FileBestStore store{path};
+    EXPECT_EQ(store.load(), 7);
+    EXPECT_TRUE(store.ready());
+    store.save(5);
+    store.save(9);
+    store.save(12);
+  }
+  EXPECT_EQ(readFile(path), "12\n");
+
+  // Рекорд ниже записанного в файле не затирает его даже до чтения
+  {
+    FileBestStore store{path};
+    store.save(3);
+    EXPECT_EQ(store.load(), 12);
+  }
+  EXPECT_EQ(readFile(path), "12\n");
+  std::remove(path.c_str());
+}
+
+TEST(Persist, EngineConstructionDoesNotWaitForFile) {
+  const std::string path = "tmp_persist_engine.txt";
+  {
+    std::ofstream(path) << 31 << "\n";
+  }
+  Engine e{Config{10, 10, 1, false, path}};
+  e.dispatch(Event::kStart);
+  EXPECT_EQ(e.snapshot().best, 31);
+  std::remove(path.c_str());
+}
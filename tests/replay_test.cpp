@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "brick_game/snake/backend.h"
+#include "brick_game/snake/replay.h"
+
+using namespace s21::snake;
+
+namespace {
+
+struct Recorded {
+  std::vector<std::uint8_t> bytes;
+  int score;
+  int ticks;
+};
+
+// Партия со случайными нажатиями, в том числе несколькими за тик,
+// паузами и перезапуском после первой смерти
+Recorded recordGame(const Config& cfg, unsigned salt) {
+  Engine e{cfg};
+  ReplayRecorder rec{cfg};
+  auto send = [&](Event ev) {
+    e.dispatch(ev);
+    rec.record(ev);
+  };
+
+  send(Event::kStart);
+  unsigned r = salt;
+  int restarts = 0, ticks = 0;
+  while (ticks < 20000) {
+    if (e.state() == State::kGameOver) {
+      if (restarts++ == 1) break;
+      send(Event::kStart);
+    }
+    r = r * 1103515245u + 12345u;
+    const unsigned roll = (r >> 24) % 16;
+    if (roll < 4)
+      send(static_cast<Event>(static_cast<int>(Event::kMoveUp) + roll));
+    if (roll == 5) send(Event::kPauseToggle);
+    if (e.state() == State::kPaused && roll > 8) send(Event::kPauseToggle);
+    send(Event::kTick);
+    ++ticks;
+  }
+  rec.finish(e.view().score);
+  return {rec.bytes(), e.view().score, ticks};
+}
+
+}  // namespace
+
+TEST(SnakeReplay, PlaybackReproducesScore) {
+  for (unsigned seed = 1; seed <= 20; ++seed) {
+    const Config cfg{14, 11, seed, seed % 2 == 0, {}, false};
+    const Recorded rec = recordGame(cfg, seed * 31u);
+    const ReplayResult res = playReplay(rec.bytes);
+    ASSERT_TRUE(res.valid) << "seed " << seed;
+    EXPECT_TRUE(res.score_matches);
+    EXPECT_EQ(res.score, rec.score);
+    EXPECT_EQ(res.ticks, static_cast<std::uint64_t>(rec.ticks));
+  }
+}
+
+TEST(SnakeReplay, QuietTicksCostAlmostNothing) {
+  const Config cfg{20, 20, 7, true, {}, false};
+  Engine e{cfg};
+  ReplayRecorder rec{cfg};
+  e.dispatch(Event::kStart);
+  rec.record(Event::kStart);
+  for (int t = 0; t < 100000; ++t) {
+    e.dispatch(Event::kTick);
+    rec.record(Event::kTick);
+  }
+  rec.finish(e.view().score);
+  EXPECT_LT(rec.bytes().size(), 24u);
+  EXPECT_TRUE(playReplay(rec.bytes()).score_matches);
+}
+
+TEST(SnakeReplay, DetectsTamperedScore) {
+  Recorded rec = recordGame(Config{12, 12, 3, false, {}, false}, 5);
+  ASSERT_LT(rec.score, 127);
+  rec.bytes.back() = static_cast<std::uint8_t>(rec.score + 1);
+  const ReplayResult res = playReplay(rec.bytes);
+  EXPECT_TRUE(res.valid);
+  EXPECT_FALSE(res.score_matches);
+  EXPECT_EQ(res.recorded_score, rec.score + 1);
+}
+
+TEST(SnakeReplay, RejectsDamagedData) {
+  const Recorded rec = recordGame(Config{12, 12, 3, false, {}, false}, 5);
+  std::vector<std::uint8_t> cut(rec.bytes.begin(), rec.bytes.end() - 2);
+  EXPECT_FALSE(playReplay(cut).valid);
+
+  std::vector<std::uint8_t> bad_magic = rec.bytes;
+  bad_magic[0] = 'X';
+  EXPECT_FALSE(playReplay(bad_magic).valid);
+
+  // Поле 2x2 движок не примет
+  ReplayRecorder tiny{Config{4, 4, 1, false, {}, false}};
+  tiny.finish(0);
+  std::vector<std::uint8_t> small = tiny.bytes();
+  small[5] = 2;
+  EXPECT_FALSE(playReplay(small).valid);
+}
+
+TEST(SnakeReplay, FileRoundTrip) {
+  const Config cfg{10, 10, 9, false, {}, false};
+  Engine e{cfg};
+  ReplayRecorder writer{cfg};
+  for (Event ev : {Event::kStart, Event::kTick, Event::kMoveDown, Event::kTick,
+                   Event::kTick}) {
+    e.dispatch(ev);
+    writer.record(ev);
+  }
+  writer.finish(e.view().score);
+
+  const std::string path = ::testing::TempDir() + "snake_replay_test.bin";
+  ASSERT_TRUE(writer.save(path));
+  std::vector<std::uint8_t> loaded;
+  ASSERT_TRUE(loadReplay(path, loaded));
+  EXPECT_EQ(loaded, writer.bytes());
+  EXPECT_TRUE(playReplay(loaded).score_matches);
+  std::remove(path.c_str());
+
+  std::vector<std::uint8_t> missing;
+  EXPECT_FALSE(loadReplay(path, missing));
+}
+
+TEST(SnakeReplay, RejectsHugeBoardsTickRunsAndScores) {
+  auto put = [](std::vector<std::uint8_t>& out, std::uint64_t v) {
+    for (; v >= 0x80; v >>= 7)
+      out.push_back(static_cast<std::uint8_t>(v | 0x80));
+    out.push_back(static_cast<std::uint8_t>(v));
+  };
+  // Заголовок, kStart и серия тиков до конца записи
+  auto replay = [&](std::uint64_t side, std::uint64_t ticks,
+                    std::uint64_t score) {
+    std::vector<std::uint8_t> out{'S', '2', '1', 'R', 2};
+    for (std::uint64_t v : {side, side, std::uint64_t{1}, std::uint64_t{0}})
+      put(out, v);
+    put(out, 0);
+    out.push_back(static_cast<std::uint8_t>(Event::kStart));
+    put(out, ticks);
+    out.push_back(0xFF);
+    put(out, score);
+    return out;
+  };
+
+  // Поле 32767x32767 заняло бы десятки гигабайт
+  EXPECT_FALSE(playReplay(replay(0x7FFF, 0, 0)).valid);
+  EXPECT_FALSE(playReplay(replay(10, std::uint64_t{1} << 40, 0)).valid);
+  EXPECT_FALSE(playReplay(replay(10, 10, std::uint64_t{1} << 31)).valid);
+
+  // Змейка разбивается о стену за несколько тиков: остаток серии не
+  // прокручивается
+  const ReplayResult r = playReplay(replay(10, std::uint64_t{1} << 24, 0));
+  EXPECT_TRUE(r.valid);
+  EXPECT_EQ(r.state, State::kGameOver);
+  EXPECT_EQ(r.ticks, std::uint64_t{1} << 24);
+}
@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+
+#include "brick_game/snake/ring_buffer.h"
+
+using s21::snake::RingBuffer;
+
+TEST(RingBuffer, WrapsAroundWithoutGrowing) {
+  RingBuffer<int> rb;
+  rb.reset(4);
+  rb.push_front(1);
+  rb.push_back(0);
+
+  for (int v = 2; v < 50; ++v) {
+    rb.push_front(v);
+    if (rb.size() > 3) rb.pop_back();
+    ASSERT_EQ(rb.front(), v);
+    ASSERT_EQ(rb[1], v - 1);
+    ASSERT_EQ(rb.back(), v - (int)rb.size() + 1);
+  }
+  EXPECT_EQ(rb.capacity(), 4u);
+
+  int expect = 49;
+  for (int v : rb) EXPECT_EQ(v, expect--);
+
+  rb.clear();
+  EXPECT_TRUE(rb.empty());
+  EXPECT_EQ(rb.capacity(), 4u);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+
+#include "brick_game/common/pcg32.h"
+#include "brick_game/snake/rules.h"
+
+using namespace s21::snake;
+
+TEST(Pcg32, MatchesReferenceSequence) {
+  // pcg32-demo из эталонной реализации: seed 42, stream 54
+  pcg32_t r;
+  pcg32_seed(&r, 42u, 54u);
+  const std::uint32_t expected[] = {0xa15c02b7, 0x7b47f409, 0xba1d3330,
+                                    0x83d2f293, 0xbfa4784b, 0xcbed606e};
+  for (std::uint32_t v : expected) EXPECT_EQ(pcg32_next(&r), v);
+}
+
+TEST(Pcg32, AdvanceSkipsAhead) {
+  pcg32_t a, b;
+  pcg32_seed(&a, 7u, 3u);
+  b = a;
+  for (int i = 0; i < 12345; ++i) (void)pcg32_next(&a);
+  pcg32_advance(&b, 12345u);
+  EXPECT_EQ(a.state, b.state);
+  EXPECT_EQ(pcg32_next(&a), pcg32_next(&b));
+
+  // Прыжок на 2^64 - 1 возвращает генератор на шаг назад
+  pcg32_advance(&b, ~std::uint64_t{0});
+  pcg32_t c;
+  pcg32_seed(&c, 7u, 3u);
+  pcg32_advance(&c, 12345u);
+  EXPECT_EQ(b.state, c.state);
+}
+
+TEST(Pcg32, StreamsDiffer) {
+  pcg32_t a, b;
+  pcg32_seed(&a, 1u, 1u);
+  pcg32_seed(&b, 1u, 2u);
+  int same = 0;
+  for (int i = 0; i < 1000; ++i) same += pcg32_next(&a) == pcg32_next(&b);
+  EXPECT_LT(same, 3);
+}
+
+TEST(Pcg32, BoundedIsInRangeAndUniform) {
+  rules::Rng r = rules::seedState(5);
+  std::array<int, 7> hist{};
+  constexpr int kDraws = 70000;
+  for (int i = 0; i < kDraws; ++i) {
+    const int v = rules::bounded(r, 7);
+    ASSERT_GE(v, 0);
+    ASSERT_LT(v, 7);
+    ++hist[v];
+  }
+  for (int h : hist) EXPECT_NEAR(h, kDraws / 7, kDraws / 70);
+
+  // n = 1 не тратит повторов и всегда дает 0
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(rules::bounded(r, 1), 0);
+}
+
+TEST(Pcg32, SnakeSeedsAreReproducible) {
+  rules::Rng a = rules::seedState(11), b = rules::seedState(11);
+  rules::Rng c = rules::seedState(12);
+  for (int i = 0; i < 100; ++i) {
+    const unsigned x = rules::nextRand(a);
+    EXPECT_EQ(x, rules::nextRand(b));
+    EXPECT_NE(x, rules::nextRand(c));
+  }
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include "brick_game/snake/backend.h"
+#include "brick_game/snake/rules.h"
+
+using namespace s21::snake;
+
+namespace {
+
+// Псевдослучайные повороты, зависящие только от состояния партии
+Direction wander(const Engine& e) {
+  const Point h = e.head();
+  const unsigned mix = h.x * 73856093u ^ h.y * 19349663u ^ e.length() * 83u;
+  return (mix >> 7) % 5 < 3 ? e.direction() : static_cast<Direction>(mix % 4);
+}
+
+// Гамильтонов цикл по полю с четной высотой (см. snake_bench.cpp)
+Direction cycle(const Engine& e, int w, int h) {
+  const Point p = e.head();
+  if (p.x == 0) return p.y == 0 ? Direction::kRight : Direction::kUp;
+  if (p.y % 2 == 0) return p.x < w - 1 ? Direction::kRight : Direction::kDown;
+  if (p.x > 1) return Direction::kLeft;
+  return p.y == h - 1 ? Direction::kLeft : Direction::kDown;
+}
+
+}  // namespace
+
+TEST(SnakeRun, MatchesDispatchLoop) {
+  for (unsigned seed = 1; seed <= 30; ++seed) {
+    const Config cfg{11, 9, seed, false, {}, false};
+    Engine fast{cfg}, slow{cfg};
+    fast.dispatch(Event::kStart);
+    slow.dispatch(Event::kStart);
+
+    const RunResult r = fast.run(5000, wander);
+    int ticks = 0;
+    while (slow.state() == State::kRunning && ticks < 5000) {
+      slow.dispatch(rules::moveEvent(wander(slow)));
+      slow.dispatch(Event::kTick);
+      ++ticks;
+    }
+
+    EXPECT_EQ(r.ticks, ticks) << "seed " << seed;
+    EXPECT_EQ(r.reason, slow.state() == State::kGameOver
+                            ? StopReason::kDeath
+                            : StopReason::kTickCap);
+    const Snapshot a = fast.snapshot(), b = slow.snapshot();
+    EXPECT_EQ(a.state, b.state);
+    EXPECT_EQ(a.score, b.score);
+    EXPECT_EQ(a.level, b.level);
+    EXPECT_EQ(a.food, b.food);
+    EXPECT_EQ(a.snake, b.snake);
+    EXPECT_EQ(a.grid, b.grid);
+  }
+}
+
+TEST(SnakeRun, StopsAtTickCapAndResumes) {
+  Engine e{Config{16, 16, 4, false, {}, false}};
+  e.dispatch(Event::kStart);
+  auto policy = [](const Engine& en) { return cycle(en, 16, 16); };
+
+  const RunResult first = e.run(10, policy);
+  EXPECT_EQ(first.reason, StopReason::kTickCap);
+  EXPECT_EQ(first.ticks, 10);
+  EXPECT_TRUE(e.changes().full_redraw);
+  EXPECT_EQ(e.state(), State::kRunning);
+
+  EXPECT_EQ(e.run(10, policy).ticks, 10);
+}
+
+TEST(SnakeRun, ReportsBoardFull) {
+  const int w = 6, h = 4;
+  Engine e{Config{w, h, 9, false, {}, false}};
+  e.dispatch(Event::kStart);
+  const RunResult r =
+      e.run(100000, [&](const Engine& en) { return cycle(en, w, h); });
+  EXPECT_EQ(r.reason, StopReason::kBoardFull);
+  EXPECT_EQ(e.length(), static_cast<std::size_t>(w * h));
+  EXPECT_EQ(e.food(), std::make_pair(-1, -1));
+}
+
+TEST(SnakeRun, ReportsDeathAndSetsChangeFlags) {
+  Engine e{Config{8, 5, 0, false, {}, false}};
+  e.dispatch(Event::kStart);
+  const RunResult r =
+      e.run(100, [](const Engine&) { return Direction::kRight; });
+  EXPECT_EQ(r.reason, StopReason::kDeath);
+  EXPECT_EQ(e.state(), State::kGameOver);
+  EXPECT_TRUE(e.changes().state_changed);
+}
+
+TEST(SnakeRun, DoesNothingUnlessRunning) {
+  Engine e{Config{8, 8, 0, false, {}, false}};
+  const RunResult r = e.run(100, [](const Engine&) { return Direction::kUp; });
+  EXPECT_EQ(r.reason, StopReason::kNotRunning);
+  EXPECT_EQ(r.ticks, 0);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "brick_game/snake/runner.h"
+
+using namespace s21::snake;
+
+namespace {
+
+// Поворот по часовой стрелке перед стеной: партии длятся сотни тиков
+Direction clockwise(const Engine& e) {
+  const Point h = e.head();
+  const Direction d = e.direction();
+  switch (d) {
+    case Direction::kRight:
+      return h.x + 1 < 12 ? d : Direction::kDown;
+    case Direction::kDown:
+      return h.y + 1 < 10 ? d : Direction::kLeft;
+    case Direction::kLeft:
+      return h.x > 0 ? d : Direction::kUp;
+    case Direction::kUp:
+      break;
+  }
+  return h.y > 0 ? d : Direction::kRight;
+}
+
+RunnerConfig smallRun() {
+  RunnerConfig cfg;
+  cfg.board = Config{12, 10, 0, false, {}, false};
+  cfg.games = 300;
+  cfg.first_seed = 17;
+  cfg.max_ticks = 400;
+  cfg.chunk = 7;
+  return cfg;
+}
+
+}  // namespace
+
+TEST(SnakeRunner, ResultsDoNotDependOnThreadCount) {
+  RunnerConfig cfg = smallRun();
+  cfg.threads = 1;
+  const RunStats reference = runGames(cfg, clockwise);
+  EXPECT_EQ(reference.games, 300u);
+  EXPECT_GT(reference.sum_score, 0u);
+
+  for (int threads : {2, 3, 8}) {
+    cfg.threads = threads;
+    EXPECT_EQ(runGames(cfg, clockwise), reference) << threads << " threads";
+  }
+}
+
+TEST(SnakeRunner, StatsMatchSequentialGames) {
+  const RunnerConfig cfg = smallRun();
+  RunStats expected;
+  Config board = cfg.board;
+  for (unsigned g = 0; g < cfg.games; ++g) {
+    board.seed = cfg.first_seed + g;
+    expected.add(playGame(board, clockwise, cfg.max_ticks));
+  }
+  RunnerConfig threaded = cfg;
+  threaded.threads = 4;
+  EXPECT_EQ(runGames(threaded, clockwise), expected);
+}
+
+TEST(SnakeRunner, TickCapStopsGame) {
+  const GameResult r =
+      playGame(Config{12, 10, 3, false, {}, false}, clockwise, 5);
+  EXPECT_EQ(r.ticks, 5);
+  EXPECT_FALSE(r.died);
+}
+
+TEST(SnakeRunner, PolicyExceptionReachesCaller) {
+  RunnerConfig cfg = smallRun();
+  cfg.threads = 3;
+  EXPECT_THROW(runGames(cfg,
+                        [](const Engine&) -> Direction {
+                          throw std::runtime_error("bad policy");
+                        }),
+               std::runtime_error);
+}
+
+TEST(SnakeRunner, SharedMemoryBestStoreSeesBestScore) {
+  MemoryBestStore best;
+  RunnerConfig cfg = smallRun();
+  cfg.board.persist = true;
+  cfg.board.best_store = &best;
+  cfg.threads = 4;
+  const RunStats s = runGames(cfg, clockwise);
+  EXPECT_EQ(best.best(), s.max_score);
+}
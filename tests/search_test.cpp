@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <vector>
+
+#include "alloc_counter.h"
+#include "brick_game/snake/rules.h"
+#include "brick_game/snake/search.h"
+
+using namespace s21::snake;
+
+namespace {
+
+// Эталонный BFS по снимку движка
+std::vector<int> referenceField(const Engine& e, Point from, bool tail_free) {
+  const Snapshot s = e.snapshot();
+  const int w = s.width, h = s.height;
+  const int tail = s.snake.back().second * w + s.snake.back().first;
+  auto passable = [&](int i) {
+    return s.grid[i] != Cell::kSnake || (tail_free && i == tail);
+  };
+  std::vector<int> dist(w * h, -1);
+  std::deque<int> q{from.y * w + from.x};
+  dist[q.front()] = 0;
+  while (!q.empty()) {
+    const int i = q.front();
+    q.pop_front();
+    const int dx[] = {0, 0, -1, 1}, dy[] = {-1, 1, 0, 0};
+    for (int k = 0; k < 4; ++k) {
+      int x = i % w + dx[k], y = i / w + dy[k];
+      if (e.wrap()) {
+        x = (x + w) % w;
+        y = (y + h) % h;
+      } else if (x < 0 || x >= w || y < 0 || y >= h) {
+        continue;
+      }
+      const int j = y * w + x;
+      if (dist[j] >= 0 || !passable(j)) continue;
+      dist[j] = dist[i] + 1;
+      q.push_back(j);
+    }
+  }
+  return dist;
+}
+
+int referenceArea(const Engine& e, Point from, bool tail_free) {
+  const std::vector<int> dist = referenceField(e, from, tail_free);
+  const Snapshot s = e.snapshot();
+  const int tail = s.snake.back().second * s.width + s.snake.back().first;
+  int area = 0;
+  for (int i = 0; i < static_cast<int>(dist.size()); ++i) {
+    const bool passable =
+        s.grid[i] != Cell::kSnake || (tail_free && i == tail);
+    area += dist[i] >= 0 && passable;
+  }
+  return area;
+}
+
+// Бот без поиска: к еде, если следующая клетка свободна, иначе в любую
+// свободную — змейка вырастает и успевает изогнуться
+Direction cautious(const Engine& e) {
+  const Point h = e.head();
+  auto safe = [&](Direction d) {
+    int x = h.x + rules::deltaX(d), y = h.y + rules::deltaY(d);
+    if (e.wrap()) {
+      x = (x + e.width()) % e.width();
+      y = (y + e.height()) % e.height();
+    }
+    return x >= 0 && x < e.width() && y >= 0 && y < e.height() &&
+           !e.isSnakeCell(x, y) && !rules::isOpposite(e.direction(), d);
+  };
+  const auto [fx, fy] = e.food();
+  const Direction want = fx > h.x   ? Direction::kRight
+                         : fx < h.x ? Direction::kLeft
+                         : fy > h.y ? Direction::kDown
+                                    : Direction::kUp;
+  if (safe(want)) return want;
+  for (Direction d : {Direction::kUp, Direction::kDown, Direction::kLeft,
+                      Direction::kRight})
+    if (safe(d)) return d;
+  return e.direction();
+}
+
+// Сверяет обе реализации с эталоном в нескольких точках партии
+void checkGame(const Config& cfg) {
+  Engine e{cfg};
+  e.dispatch(Event::kStart);
+  BoardSearch fast, scalar(BoardSearch::Mode::kScalar);
+  unsigned r = cfg.seed;
+  for (int round = 0; round < 40 && e.state() == State::kRunning; ++round) {
+    (void)e.run(7, cautious);
+    if (e.state() != State::kRunning) break;
+    r = r * 1103515245u + 12345u;
+    const Point h = e.head();
+    const Point probes[] = {
+        h, e.tail(),
+        Point{static_cast<Coord>((r >> 8) % cfg.width),
+              static_cast<Coord>((r >> 20) % cfg.height)}};
+    for (const Point& p : probes) {
+      for (bool tail_free : {true, false}) {
+        const std::vector<int> want = referenceField(e, p, tail_free);
+        const std::span<const int> got = fast.distanceField(e, p, tail_free);
+        ASSERT_TRUE(std::equal(want.begin(), want.end(), got.begin()))
+            << cfg.width << "x" << cfg.height << " round " << round;
+        const std::span<const int> ref = scalar.distanceField(e, p, tail_free);
+        ASSERT_TRUE(std::equal(want.begin(), want.end(), ref.begin()));
+
+        const int area = referenceArea(e, p, tail_free);
+        EXPECT_EQ(fast.reachableArea(e, p, tail_free), area);
+        EXPECT_EQ(scalar.reachableArea(e, p, tail_free), area);
+
+        const auto [fx, fy] = e.food();
+        const Point food{static_cast<Coord>(fx), static_cast<Coord>(fy)};
+        const int to_food = want[fy * cfg.width + fx];
+        EXPECT_EQ(fast.distance(e, p, food, tail_free), to_food);
+        EXPECT_EQ(scalar.distance(e, p, food, tail_free), to_food);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(BoardSearch, MatchesReferenceOnWalledBoards) {
+  checkGame(Config{20, 20, 3, false, {}, false});
+  checkGame(Config{10, 7, 8, false, {}, false});
+  checkGame(Config{64, 12, 5, false, {}, false});
+  checkGame(Config{63, 9, 6, false, {}, false});
+}
+
+TEST(BoardSearch, MatchesReferenceOnTorus) {
+  checkGame(Config{20, 20, 4, true, {}, false});
+  checkGame(Config{13, 11, 9, true, {}, false});
+  checkGame(Config{64, 8, 2, true, {}, false});
+}
+
+TEST(BoardSearch, WideBoardFallsBackToQueue) {
+  checkGame(Config{70, 10, 7, false, {}, false});
+  checkGame(Config{100, 6, 1, true, {}, false});
+}
+
+TEST(BoardSearch, OutOfBoardQueries) {
+  Engine e{Config{10, 10, 1, false, {}, false}};
+  e.dispatch(Event::kStart);
+  BoardSearch s;
+  EXPECT_EQ(s.reachableArea(e, Point{-1, 0}), 0);
+  EXPECT_EQ(s.distance(e, e.head(), Point{10, 0}), -1);
+  for (int d : s.distanceField(e, Point{0, 10})) EXPECT_EQ(d, -1);
+
+  // Начало занято головой: само не считается, до соседей один шаг
+  const Point h = e.head();
+  EXPECT_EQ(s.reachableArea(e, h, false),
+            static_cast<int>(e.freeCells()));
+  EXPECT_EQ(s.distance(e, h, h), -1);
+  EXPECT_EQ(s.distanceField(e, h)[h.y * 10 + h.x], 0);
+}
+
+TEST(BoardSearch, DoesNotAllocateAfterFirstQuery) {
+  Engine e{Config{20, 20, 9, false, {}, false}};
+  e.dispatch(Event::kStart);
+  (void)e.run(50, cautious);
+  BoardSearch fast, scalar(BoardSearch::Mode::kScalar);
+  const Point h = e.head(), t = e.tail();
+  (void)fast.reachableArea(e, h);
+  (void)fast.distanceField(e, h);
+  (void)scalar.distanceField(e, h);
+
+  alloc_counter::AllocScope scope;
+  for (BoardSearch* s : {&fast, &scalar}) {
+    (void)s->reachableArea(e, h);
+    (void)s->distanceField(e, h);
+    (void)s->distance(e, h, t);
+  }
+  EXPECT_EQ(scope.count(), 0);
+}
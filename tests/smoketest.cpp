@@ -8,7 +8,7 @@ using s21::snake::Event;
 using s21::snake::State;
 
 TEST(SnakeMove, StartThenTickMovesRight) {
-  Engine e{Config{20, 20, 0, false}};
+  Engine e{Config{20, 20, 0, false, {}, false}};
   e.dispatch(Event::kStart);
   auto before = e.snapshot().snake.front();
   auto [bx, by] = before;
@@ -23,7 +23,7 @@ TEST(SnakeMove, StartThenTickMovesRight) {
 }
 
 TEST(SnakeMove, OppositeTurnIsIgnored) {
-  Engine e{};
+  Engine e{Config{20, 20, 0, false, {}, false}};
   e.dispatch(Event::kStart);
   auto [bx, by] = e.snapshot().snake.front();
   e.dispatch(Event::kMoveLeft);
@@ -34,7 +34,7 @@ TEST(SnakeMove, OppositeTurnIsIgnored) {
 }
 
 TEST(SnakeMove, TurnUpChangesDY) {
-  Engine e{};
+  Engine e{Config{20, 20, 0, false, {}, false}};
   e.dispatch(Event::kStart);
   auto [bx, by] = e.snapshot().snake.front();
   e.dispatch(Event::kMoveUp);
@@ -45,11 +45,47 @@ TEST(SnakeMove, TurnUpChangesDY) {
 }
 
 TEST(SnakeMove, HitWallLeadsToGameOver) {
-  Engine e{Config{8, 5, 0, false}};
+  Engine e{Config{8, 5, 0, false, {}, false}};
   e.dispatch(Event::kStart);
 
   for (int i = 0; i < 20 && e.state() == State::kRunning; ++i) {
     e.dispatch(Event::kTick);
   }
   EXPECT_EQ(e.state(), State::kGameOver);
-}
\ No newline at end of file
+}
+TEST(SnakeMove, HeadMayFollowTailIntoVacatedCell) {
+  Engine e{Config{12, 8, 777, false, {}, false}};
+  e.dispatch(Event::kStart);
+
+  for (int guard = 0; guard < 400 && e.snapshot().score == 0; ++guard) {
+    auto s = e.snapshot();
+    auto [fx, fy] = s.food;
+    auto [hx, hy] = s.snake.front();
+    if (fx > hx)
+      e.dispatch(Event::kMoveRight);
+    else if (fx < hx)
+      e.dispatch(Event::kMoveLeft);
+    else if (fy < hy)
+      e.dispatch(Event::kMoveUp);
+    else if (fy > hy)
+      e.dispatch(Event::kMoveDown);
+    e.dispatch(Event::kTick);
+  }
+  ASSERT_EQ(e.state(), State::kRunning);
+  ASSERT_EQ(e.length(), 4u);
+
+  // Змейка длины 4 ходит по квадрату 2x2: каждый тик голова занимает
+  // клетку, которую в этот же тик покидает хвост.
+  auto h = e.head();
+  const bool down = h.y + 1 < e.snapshot().height;
+  const Event loop[] = {down ? Event::kMoveDown : Event::kMoveUp,
+                        Event::kMoveLeft,
+                        down ? Event::kMoveUp : Event::kMoveDown,
+                        Event::kMoveRight};
+  for (int i = 0; i < 12; ++i) {
+    e.dispatch(loop[i % 4]);
+    e.dispatch(Event::kTick);
+    ASSERT_EQ(e.state(), State::kRunning) << "tick " << i;
+  }
+  EXPECT_EQ(e.length(), 4u);
+}
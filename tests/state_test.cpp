@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "brick_game/snake/backend.h"
+#include "brick_game/snake/rules.h"
+
+using namespace s21::snake;
+
+namespace {
+
+// Детерминированный поток событий с несколькими нажатиями на тик
+void drive(Engine& e, unsigned& r, int ticks) {
+  for (int t = 0; t < ticks && e.state() == State::kRunning; ++t) {
+    r = r * 1103515245u + 12345u;
+    if ((r >> 28) < 5)
+      e.dispatch(rules::moveEvent(static_cast<Direction>((r >> 16) % 4)));
+    if ((r >> 28) == 0)
+      e.dispatch(rules::moveEvent(static_cast<Direction>((r >> 12) % 4)));
+    e.dispatch(Event::kTick);
+  }
+}
+
+void expectSameGame(const Engine& a, const Engine& b) {
+  const Snapshot x = a.snapshot(), y = b.snapshot();
+  EXPECT_EQ(x.state, y.state);
+  EXPECT_EQ(x.score, y.score);
+  EXPECT_EQ(x.best, y.best);
+  EXPECT_EQ(x.level, y.level);
+  EXPECT_EQ(x.speed_ms, y.speed_ms);
+  EXPECT_EQ(x.food, y.food);
+  EXPECT_EQ(x.snake, y.snake);
+  EXPECT_EQ(x.grid, y.grid);
+  EXPECT_EQ(a.direction(), b.direction());
+  EXPECT_EQ(a.queuedMoves(), b.queuedMoves());
+  EXPECT_EQ(a.freeCells(), b.freeCells());
+}
+
+std::string tempPath(const char* name) {
+  return ::testing::TempDir() + name;
+}
+
+int readBest(const std::string& path) {
+  std::ifstream in(path);
+  int v = -1;
+  in >> v;
+  return v;
+}
+
+}  // namespace
+
+TEST(SnakeState, SaveLoadContinuesIdentically) {
+  for (unsigned seed = 1; seed <= 15; ++seed) {
+    const Config cfg{13, 11, seed, seed % 3 == 0, {}, false};
+    Engine a{cfg};
+    a.dispatch(Event::kStart);
+    unsigned r = seed;
+    drive(a, r, 150);
+    a.dispatch(Event::kMoveUp);  // непустая очередь в блоке
+
+    std::vector<std::uint8_t> blob;
+    a.saveState(blob);
+    Engine b{Config{13, 11, 999, false, {}, false}};
+    ASSERT_TRUE(b.loadState(blob)) << "seed " << seed;
+    expectSameGame(a, b);
+
+    unsigned ra = r, rb = r;
+    drive(a, ra, 2000);
+    drive(b, rb, 2000);
+    expectSameGame(a, b);
+  }
+}
+
+TEST(SnakeState, CloneIntoContinuesIdenticallyWithoutReallocating) {
+  Engine root{Config{20, 20, 5, false, {}, false}};
+  root.dispatch(Event::kStart);
+  unsigned r = 11;
+  drive(root, r, 300);
+
+  Engine arena = root;
+  const auto* grid = arena.view().grid.data();
+  for (int k = 0; k < 20; ++k) {
+    root.cloneInto(arena);
+    EXPECT_EQ(arena.view().grid.data(), grid);
+    expectSameGame(root, arena);
+    unsigned rr = r + k;
+    drive(arena, rr, 200);
+  }
+
+  Engine copy = root;
+  unsigned ra = r, rb = r;
+  drive(root, ra, 1000);
+  drive(copy, rb, 1000);
+  expectSameGame(root, copy);
+}
+
+TEST(SnakeState, ClonesNeverWriteBestFile) {
+  const std::string path = tempPath("snake_state_best.txt");
+  std::remove(path.c_str());
+  {
+    std::ofstream(path) << 0 << "\n";
+  }
+
+  Engine root{Config{10, 10, 3, false, path}};
+  root.dispatch(Event::kStart);
+  {
+    Engine clone = root;
+    Engine arena{Config{10, 10, 1, false, {}, false}};
+    root.cloneInto(arena);
+    // Клон играет, набирает очки и погибает — файл рекорда не меняется
+    auto eat = [](const Engine& e) {
+      const auto [fx, fy] = e.food();
+      const Point h = e.head();
+      const Direction d = e.direction();
+      if (fx > h.x && d != Direction::kLeft) return Direction::kRight;
+      if (fx < h.x && d != Direction::kRight) return Direction::kLeft;
+      if (fy > h.y && d != Direction::kUp) return Direction::kDown;
+      if (fy < h.y && d != Direction::kDown) return Direction::kUp;
+      return d == Direction::kUp ? Direction::kLeft : Direction::kUp;
+    };
+    clone.run(5000, eat);
+    arena.run(5000, eat);
+    EXPECT_GT(clone.view().score, 0);
+    EXPECT_EQ(clone.state(), State::kGameOver);
+  }
+  EXPECT_EQ(readBest(path), 0);
+  std::remove(path.c_str());
+}
+
+TEST(SnakeState, RejectsForeignOrDamagedBlobs) {
+  Engine a{Config{12, 12, 4, false, {}, false}};
+  a.dispatch(Event::kStart);
+  unsigned r = 3;
+  drive(a, r, 50);
+  std::vector<std::uint8_t> blob;
+  a.saveState(blob);
+
+  Engine other{Config{12, 14, 4, false, {}, false}};
+  EXPECT_FALSE(other.loadState(blob));
+
+  Engine b{Config{12, 12, 4, false, {}, false}};
+  std::vector<std::uint8_t> cut(blob.begin(), blob.end() - 1);
+  EXPECT_FALSE(b.loadState(cut));
+  EXPECT_EQ(b.state(), State::kInit);
+  EXPECT_EQ(b.length(), 3u);
+
+  // Чужая сигнатура
+  std::vector<std::uint8_t> bad = blob;
+  bad[0] = 'X';
+  EXPECT_FALSE(b.loadState(bad));
+
+  EXPECT_TRUE(b.loadState(blob));
+  expectSameGame(a, b);
+}
+
+TEST(SnakeState, DamagedBlobLeavesFreshGame) {
+  Engine a{Config{12, 12, 4, true, {}, false}};
+  a.dispatch(Event::kStart);
+  unsigned r = 7;
+  drive(a, r, 40);
+  std::vector<std::uint8_t> blob;
+  a.saveState(blob);
+  blob.push_back(0);
+
+  // Поля до тела уже прочитаны, когда обнаруживается лишний байт
+  Engine b{Config{12, 12, 4, false, {}, false}};
+  EXPECT_FALSE(b.loadState(blob));
+  EXPECT_FALSE(b.wrap());
+  expectSameGame(b, Engine{Config{12, 12, 4, false, {}, false}});
+}
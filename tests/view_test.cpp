@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include "brick_game/snake/backend.h"
+
+using namespace s21::snake;
+
+static void expectSameState(const Snapshot& s, const SnapshotView& v) {
+  ASSERT_EQ(s.state, v.state);
+  ASSERT_EQ(s.width, v.width);
+  ASSERT_EQ(s.height, v.height);
+  ASSERT_EQ(s.score, v.score);
+  ASSERT_EQ(s.best, v.best);
+  ASSERT_EQ(s.level, v.level);
+  ASSERT_EQ(s.speed_ms, v.speed_ms);
+  ASSERT_EQ(s.food, v.food);
+  ASSERT_TRUE(std::equal(s.grid.begin(), s.grid.end(), v.grid.begin(),
+                         v.grid.end()));
+  ASSERT_EQ(s.snake.size(), v.snake.size());
+  std::size_t i = 0;
+  for (const Point& p : v.snake) {
+    ASSERT_EQ(s.snake[i], std::make_pair(p.x, p.y));
+    ASSERT_EQ(v.snake[i].x, p.x);
+    ++i;
+  }
+}
+
+TEST(SnakeView, ViewMatchesSnapshotThroughRingWrap) {
+  Engine e{Config{8, 6, 5, false, {}, false}};
+  e.dispatch(Event::kStart);
+  const Event moves[] = {Event::kMoveUp, Event::kMoveLeft, Event::kMoveDown,
+                         Event::kMoveRight};
+
+  unsigned r = 77;
+  for (int t = 0; t < 3000; ++t) {
+    if (e.state() == State::kGameOver) e.dispatch(Event::kStart);
+    r = r * 1103515245u + 12345u;
+    e.dispatch(moves[(r >> 16) % 4]);
+    e.dispatch(Event::kTick);
+    expectSameState(e.snapshot(), e.view());
+  }
+}
+
+TEST(SnakeView, ViewBorrowsEngineStorage) {
+  Engine e{Config{20, 20, 0, false, {}, false}};
+  e.dispatch(Event::kStart);
+  auto v1 = e.view();
+  auto v2 = e.view();
+  EXPECT_EQ(v1.grid.data(), v2.grid.data());
+  EXPECT_EQ(&v1.snake.front(), &v2.snake.front());
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+
+#include "brick_game/snake/backend.h"
+#include "brick_game/snake/rules.h"
+
+using namespace s21::snake;
+
+namespace {
+
+// Ведет змейку в направлении ev, пока голова не пересечет край поля
+// (или не кончится запас тиков). Возвращает число тиков.
+int runUntilWrapped(Engine& e, Event ev, int limit) {
+  e.dispatch(ev);
+  for (int t = 1; t <= limit; ++t) {
+    const Point prev = e.head();
+    e.dispatch(Event::kTick);
+    if (e.state() != State::kRunning) return -1;
+    const Point h = e.head();
+    if (std::abs(h.x - prev.x) > 1 || std::abs(h.y - prev.y) > 1) return t;
+  }
+  return 0;
+}
+
+}  // namespace
+
+TEST(SnakeWrap, WrapCoordMatchesModulo) {
+  for (int n : {4, 5, 7, 8, 16, 20, 64, 100}) {
+    const int mask = rules::wrapMask(n);
+    EXPECT_EQ(mask != 0, (n & (n - 1)) == 0) << n;
+    for (int v = -1; v <= n; ++v)
+      EXPECT_EQ(rules::wrapCoord(v, n, mask), (v + n) % n) << n << ' ' << v;
+  }
+}
+
+TEST(SnakeWrap, RightEdgeLeadsToColumnZero) {
+  Engine e{Config{10, 7, 1, true, {}, false}};
+  e.dispatch(Event::kStart);
+  while (e.head().x < 9) e.dispatch(Event::kTick);
+  const int y = e.head().y;
+  e.dispatch(Event::kTick);
+  EXPECT_EQ(e.state(), State::kRunning);
+  EXPECT_EQ(e.head().x, 0);
+  EXPECT_EQ(e.head().y, y);
+}
+
+TEST(SnakeWrap, EveryEdgeWrapsOnPowerOfTwoAndOtherSizes) {
+  for (int side : {16, 13}) {
+    for (Event ev : {Event::kMoveUp, Event::kMoveLeft, Event::kMoveDown}) {
+      Engine e{Config{side, side, 5, true, {}, false}};
+      e.dispatch(Event::kStart);
+      EXPECT_GT(runUntilWrapped(e, ev, 2 * side), 0)
+          << "side " << side << " event " << static_cast<int>(ev);
+    }
+  }
+}
+
+TEST(SnakeWrap, LongRunWithoutTurnsNeverHitsWall) {
+  // Без поворотов змейка ходит по одной строке; умереть она может только
+  // заполнив строку собственным телом
+  Engine e{Config{12, 9, 3, true, {}, false}};
+  e.dispatch(Event::kStart);
+  for (int t = 0; t < 200 && e.state() == State::kRunning; ++t)
+    e.dispatch(Event::kTick);
+  if (e.state() == State::kGameOver) {
+    EXPECT_GE(e.length(), 12u);
+  }
+}
+
+TEST(SnakeWrap, DisabledWrapStillEndsAtWall) {
+  Engine e{Config{16, 16, 5, false, {}, false}};
+  e.dispatch(Event::kStart);
+  EXPECT_EQ(runUntilWrapped(e, Event::kMoveUp, 32), -1);
+  EXPECT_EQ(e.state(), State::kGameOver);
+}
@@ -0,0 +1,47 @@
+/**
+ * @file snake_replay.cpp
+ * @brief Проверка архивных реплеев Snake
+ *
+ * @details
+ * Воспроизводит каждый файл и сверяет итоговый счет с записанным.
+ * Код возврата 0, только если все реплеи целы и совпали.
+ * Пример: snake_replay game1.s21r game2.s21r
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "brick_game/snake/replay.h"
+
+using namespace s21::snake;
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s REPLAY...\n", argv[0]);
+    return 1;
+  }
+
+  int failed = 0;
+  std::vector<std::uint8_t> data;
+  for (int i = 1; i < argc; ++i) {
+    if (!loadReplay(argv[i], data)) {
+      std::printf("%s: cannot read\n", argv[i]);
+      ++failed;
+      continue;
+    }
+    const ReplayResult r = playReplay(data);
+    if (!r.valid) {
+      std::printf("%s: damaged\n", argv[i]);
+      ++failed;
+    } else if (!r.score_matches) {
+      std::printf("%s: MISMATCH recorded %d, replayed %d (%llu ticks)\n",
+                  argv[i], r.recorded_score, r.score,
+                  static_cast<unsigned long long>(r.ticks));
+      ++failed;
+    } else {
+      std::printf("%s: ok score %d (%llu ticks)\n", argv[i], r.score,
+                  static_cast<unsigned long long>(r.ticks));
+    }
+  }
+  return failed ? 1 : 0;
+}
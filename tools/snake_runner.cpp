@@ -0,0 +1,144 @@
+/**
+ * @file snake_runner.cpp
+ * @brief Консольный прогон множества партий Snake для оценки ботов
+ *
+ * @details
+ * Пример: snake_runner --policy greedy --games 1000000 --threads 8
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+
+#include "brick_game/snake/autopilot.h"
+#include "brick_game/snake/rules.h"
+#include "brick_game/snake/runner.h"
+
+using namespace s21::snake;
+
+namespace {
+
+constexpr Direction kDirs[] = {Direction::kUp, Direction::kDown,
+                               Direction::kLeft, Direction::kRight};
+
+// Клетка, в которую шагнет голова; false — стена
+bool target(const Engine& e, const Config& board, Direction d, int& x,
+            int& y) {
+  x = e.head().x + rules::deltaX(d);
+  y = e.head().y + rules::deltaY(d);
+  if (board.wrap) {
+    x = (x + board.width) % board.width;
+    y = (y + board.height) % board.height;
+    return true;
+  }
+  return x >= 0 && x < board.width && y >= 0 && y < board.height;
+}
+
+bool safe(const Engine& e, const Config& board, Direction d) {
+  int x, y;
+  if (rules::isOpposite(d, e.direction())) return false;
+  if (!target(e, board, d, x, y)) return false;
+  const Point tail = e.tail();
+  return !e.isSnakeCell(x, y) || (tail.x == x && tail.y == y);
+}
+
+// Идет прямо, пока впереди нет препятствия, иначе первый безопасный поворот
+Direction straightPolicy(const Engine& e, const Config& board) {
+  if (safe(e, board, e.direction())) return e.direction();
+  for (Direction d : kDirs)
+    if (safe(e, board, d)) return d;
+  return e.direction();
+}
+
+// Безопасный ход, сильнее всего сокращающий манхэттенское расстояние до еды
+Direction greedyPolicy(const Engine& e, const Config& board) {
+  const auto [fx, fy] = e.food();
+  Direction best = e.direction();
+  int best_dist = -1;
+  for (Direction d : kDirs) {
+    int x, y;
+    if (!safe(e, board, d) || !target(e, board, d, x, y)) continue;
+    const int dist = std::abs(x - fx) + std::abs(y - fy);
+    if (best_dist < 0 || dist < best_dist) {
+      best = d;
+      best_dist = dist;
+    }
+  }
+  return best;
+}
+
+void usage(const char* prog) {
+  std::fprintf(stderr,
+               "usage: %s [--policy greedy|straight|autopilot] [--games N] "
+               "[--threads T]\n"
+               "          [--seed S] [--width W] [--height H] "
+               "[--max-ticks M] [--chunk C] [--wrap]\n",
+               prog);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  RunnerConfig cfg;
+  std::string policy_name = "greedy";
+
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (std::strcmp(arg, "--wrap") == 0) {
+      cfg.board.wrap = true;
+    } else if (std::strcmp(arg, "--policy") == 0 && has_value) {
+      policy_name = argv[++i];
+    } else if (std::strcmp(arg, "--games") == 0 && has_value) {
+      cfg.games = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::strcmp(arg, "--threads") == 0 && has_value) {
+      cfg.threads = std::atoi(argv[++i]);
+    } else if (std::strcmp(arg, "--seed") == 0 && has_value) {
+      cfg.first_seed =
+          static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(arg, "--width") == 0 && has_value) {
+      cfg.board.width = std::atoi(argv[++i]);
+    } else if (std::strcmp(arg, "--height") == 0 && has_value) {
+      cfg.board.height = std::atoi(argv[++i]);
+    } else if (std::strcmp(arg, "--max-ticks") == 0 && has_value) {
+      cfg.max_ticks = std::atoi(argv[++i]);
+    } else if (std::strcmp(arg, "--chunk") == 0 && has_value) {
+      cfg.chunk = std::strtoull(argv[++i], nullptr, 10);
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  const Config board = cfg.board;
+  Policy policy;
+  if (policy_name == "greedy") {
+    policy = [board](const Engine& e) { return greedyPolicy(e, board); };
+  } else if (policy_name == "straight") {
+    policy = [board](const Engine& e) { return straightPolicy(e, board); };
+  } else if (policy_name == "autopilot") {
+    policy = autopilotPolicy();
+  } else {
+    usage(argv[0]);
+    return 1;
+  }
+
+  RunStats s;
+  try {
+    s = runGames(cfg, policy);
+  } catch (const std::exception& ex) {
+    std::fprintf(stderr, "error: %s\n", ex.what());
+    return 1;
+  }
+
+  std::printf("policy       %s\n", policy_name.c_str());
+  std::printf("games        %llu\n", static_cast<unsigned long long>(s.games));
+  std::printf("deaths       %llu\n", static_cast<unsigned long long>(s.deaths));
+  std::printf("score mean   %.3f (stddev %.3f, max %d)\n", s.meanScore(),
+              s.scoreStddev(), s.max_score);
+  std::printf("length mean  %.3f (max %d)\n", s.meanLength(), s.max_length);
+  std::printf("ticks mean   %.3f (max %d)\n", s.meanTicks(), s.max_ticks);
+  return 0;
+}